@@ -120,8 +120,10 @@ int canadaJsonPerfTest() {
     Geo::Root root;
     bool res;
 
-    res = root.Deserialize(b, e);
-    if(!res) throw 1;
+    auto ctx = root.Deserialize(b, e);
+    if(!ctx) throw 1;
+    auto keyStats = ctx.keyMatchStats();
+    std::cout << "Keys predicted: " << keyStats.predicted << ", looked up: " << keyStats.lookedUp << ", unknown: " << keyStats.unknown << std::endl;
 
 //    while(true) {
 //        bool res1 = root.Deserialize(b, e);
@@ -141,14 +143,7 @@ int canadaJsonPerfTest() {
 //        }
     }
 
-   {
-        std::size_t counter = 0;
-        root.Serialize([&counter](const char * d, std::size_t size){
-            counter += size;
-            return true;
-        });
-        std::cout << "Serialized size: " << counter << std::endl;
-   }
+    std::cout << "Serialized size: " << root.SerializedSize() << std::endl;
 
 
 
@@ -167,6 +162,49 @@ int canadaJsonPerfTest() {
         outputPtr = 0;
         root.Serialize(serializingCallback);
     });
+    doPerformanceTest("canada.json serializing to a new string", 100, [&root]{
+        string out;
+        if(!root.Serialize(out)) throw 1;
+    });
+    doPerformanceTest("canada.json serializing to a new string, exact size", 100, [&root]{
+        string out;
+        if(!root.Serialize(out, JSONReflection::ExactSize)) throw 1;
+    });
+    // numbers formatting dominates canada.json serializing, compare both double formatters on them
+    vector<double> numbers;
+    for(const auto & feature : root.features) {
+        for(const auto & ring : feature.geometry.coordinates) {
+            for(const auto & point : ring) {
+                for(const auto & coordinate : point) {
+                    numbers.push_back(coordinate);
+                }
+            }
+        }
+    }
+    char numberOutput[32];
+    std::size_t shortestSize = 0;
+    doPerformanceTest("canada.json numbers, shortest formatting", 100, [&numbers, &numberOutput, &shortestSize]{
+        shortestSize = 0;
+        for(double v : numbers) {
+            shortestSize += JSONReflection::d::writeDoubleShortest(numberOutput, v) - numberOutput;
+        }
+    });
+    std::size_t grisu2Size = 0;
+    doPerformanceTest("canada.json numbers, Grisu2 formatting", 100, [&numbers, &numberOutput, &grisu2Size]{
+        grisu2Size = 0;
+        for(double v : numbers) {
+            grisu2Size += JSONReflection::d::writeDoubleGrisu2(numberOutput, v) - numberOutput;
+        }
+    });
+    std::size_t fixedSize = 0;
+    doPerformanceTest("canada.json numbers, 7 decimals formatting", 100, [&numbers, &numberOutput, &fixedSize]{
+        fixedSize = 0;
+        for(double v : numbers) {
+            fixedSize += JSONReflection::Precision<7>::writeDouble(numberOutput, v) - numberOutput;
+        }
+    });
+    std::cout << "Formatted numbers size, shortest: " << shortestSize << ", Grisu2: " << grisu2Size << ", 7 decimals: " << fixedSize << std::endl;
+
     std::ofstream outputFile("./serialised_output.json");
     outputFile.write(outputSimulator, outputPtr);
     outputFile.close();
@@ -181,6 +219,36 @@ int canadaJsonPerfTest() {
 
         if(!res) throw 1;
     });
+
+    // zero-filled padding after the data, no end checks inside tokens
+    std::string padded = inp;
+    padded.resize(inp.size() + JSONReflection::DeserializePadding);
+    doPerformanceTest("canada.json parsing, padded input", 100, [&res, &root, &padded, &inp]{
+        res = root.DeserializePadded(padded.data(), inp.size());
+        if(!res) throw 1;
+    });
+    // no validation of escapes, literals and skipped numbers
+    doPerformanceTest("canada.json parsing, trusted input", 100, [&res, &root, &inp]{
+        res = root.Deserialize(inp, JSONReflection::ParseFlags::TRUSTED_INPUT);
+        if(!res) throw 1;
+    });
+    doPerformanceTest("canada.json parsing, trusted padded input", 100, [&res, &root, &padded, &inp]{
+        res = root.DeserializePadded(padded.data(), inp.size(), JSONReflection::ParseFlags::TRUSTED_INPUT);
+        if(!res) throw 1;
+    });
+    // RFC 8259 separators, UTF-8 validated strings
+    doPerformanceTest("canada.json parsing, strict", 100, [&res, &root, &inp]{
+        res = root.Deserialize(inp, JSONReflection::ParseFlags::STRICT);
+        if(!res) throw 1;
+    });
+    JSONReflection::StructuralIndex index;
+    doPerformanceTest("canada.json structural index", 100, [&index, &inp]{
+        index.build(inp.data(), inp.size());
+    });
+    doPerformanceTest("canada.json parsing, indexed", 100, [&res, &root, &index, &inp]{
+        res = root.DeserializeIndexed(inp, index);
+        if(!res) throw 1;
+    });
     auto & feat = root.features.front();
 
     root.features[0].geometry.type = "I am deeply nested";
@@ -11,8 +11,8 @@
 #include <swl/variant.hpp>
 #include <algorithm>
 #include <fast_double_parser.h>
-#include <simdjson/to_chars.hpp>
 #include "string_ops.hpp"
+#include "number_ops.hpp"
 
 
 namespace JSONReflection {
@@ -71,6 +71,12 @@ concept StringTypeConcept = requires (T v) {
 template <typename T>
 concept StaticContainerTypeConcept = std::ranges::sized_range<T>;
 
+// std::array like containers, with the size known at compile time
+template <typename T>
+concept FixedSizeContainerConcept = requires {
+    {std::tuple_size<T>::value} -> std::convertible_to<std::size_t>;
+};
+
 
 
 template <typename T>
@@ -113,9 +119,48 @@ concept JSONObjectValue = std::is_class_v<T> && !JSONArrayValue<T> && !JSONBasic
 template<typename T>
 concept JSONWrapable = JSONBasicValue<T> || JSONArrayValue<T> || JSONObjectValue<T> || JSONMapValue<T>;
 
+template<typename T>
+concept DoubleFormatOption = requires (char * out, double value) {
+    {T::writeDouble(out, value)} -> std::same_as<char *>;
+    {T::MaxSize} -> std::convertible_to<std::size_t>;
+};
+
+struct DefaultDoubleFormat {
+    static constexpr std::size_t MaxSize = 24;
+    static char * writeDouble(char * out, double value) {
+        return d::writeDouble(out, value);
+    }
+#if !defined(CPP_JSON_REFLECTION_GRISU2_DOUBLES)
+    static std::size_t serializedSize(double value) {
+        return d::doubleShortestSize(value);
+    }
+#endif
+};
+
 }
 
-template <class Src, d::ConstString Str = "">
+// Double field options: J<double, "lat", Precision<7>> is written with at most 7 decimals,
+// J<double, "v", SignificantDigits<6>> with at most 6 significant digits. Parsing is not affected
+template <unsigned Decimals>
+struct Precision {
+    static_assert(Decimals <= 15, "JSONReflection: Precision is limited to 15 decimals");
+    // up to 19 digits in the exponent form, like -1.000000000000000125e+15
+    static constexpr std::size_t MaxSize = 25;
+    static char * writeDouble(char * out, double value) {
+        return d::writeDoubleFixed(out, value, Decimals);
+    }
+};
+
+template <unsigned Digits>
+struct SignificantDigits {
+    static_assert(Digits >= 1 && Digits <= 17, "JSONReflection: SignificantDigits should be in [1, 17]");
+    static constexpr std::size_t MaxSize = 24;
+    static char * writeDouble(char * out, double value) {
+        return d::writeDoubleSignificant(out, value, Digits);
+    }
+};
+
+template <class Src, d::ConstString Str = "", class ... Options>
 class J {
     template <class... T>
     static constexpr bool always_false = false;
@@ -123,46 +168,56 @@ class J {
     static_assert (d::JSONWrapable<Src>);
 };
 
-template <d::JSONBasicValue Src, d::ConstString Str>
-class J<Src, Str> {
+template <d::JSONBasicValue Src, d::ConstString Str, class ... Options>
+class J<Src, Str, Options...> {
+    static_assert(sizeof...(Options) == 0 || (std::same_as<double, Src> && sizeof...(Options) == 1 && (d::DoubleFormatOption<Options> && ...)),
+                  "JSONReflection: only doubles take an option, Precision<N> or SignificantDigits<N>");
+    using DoubleFormat = std::tuple_element_t<0, std::tuple<Options..., d::DefaultDoubleFormat>>;
+
     Src content;
 
-    //from 3party/simdjson/to_chars.cpp
-    char *to_chars(char *first, const char *last, double value) const {
-      static_cast<void>(last); // maybe unused - fix warning
-      bool negative = std::signbit(value);
-      if (negative) {
-        value = -value;
-        *first++ = '-';
-      }
-
-      if (value == 0) // +-0
-      {
-        *first++ = '0';
-        if(negative) {
-          *first++ = '.';
-          *first++ = '0';
+    template<class InpIter> requires InputIteratorConcept<InpIter>
+    bool deserializeDouble(InpIter & begin, const InpIter & end, DeserializationContext & ctx, double & value) {
+        const char * numberBegin = std::to_address(begin);
+        const char * numberEnd = d::parseDouble<d::isPadded<InpIter>>(numberBegin, std::to_address(end), value);
+        if(numberEnd == nullptr) [[unlikely]] {
+            ctx.setError(DeserializationContext::ILLFORMED_NUMBER, end - begin);
+            return false;
         }
-        return first;
-      }
-
-      int len = 0;
-      int decimal_exponent = 0;
-      simdjson::internal::dtoa_impl::grisu2(first, len, decimal_exponent, value);
-      // Format the buffer like printf("%.*g", prec, value)
-      constexpr int kMinExp = -4;
-      constexpr int kMaxExp = std::numeric_limits<double>::digits10;
-
-      return simdjson::internal::dtoa_impl::format_buffer(first, len, decimal_exponent, kMinExp,
-                                      kMaxExp);
+        begin += numberEnd - numberBegin;
+        if(begin == end) [[unlikely]] {
+            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
+            return false;
+        }
+        if(!d::isTrusted<InpIter> && !d::isPlainEnd(*begin)) [[unlikely]] {
+            ctx.setError(DeserializationContext::ILLFORMED_NUMBER, end - begin);
+            return false;
+        }
+        return true;
     }
 
-
 public:
     using JSONValueKind = d::JSONValueKindEnumPlain;
     static constexpr auto FieldName = Str;
     static_assert(FieldName.check() == true, "Please, use printable chars in values keys");
 
+    // Numbers, bools and fixed-size strings; custom types have no size limit
+    static constexpr bool IsHeapFree = std::same_as<bool, Src> || std::same_as<double, Src> || std::integral<Src>
+            || (d::StringTypeConcept<Src> && d::FixedSizeContainerConcept<Src>);
+
+    // Widest possible output: a string of control chars is six times longer escaped
+    static constexpr std::size_t MaxSerializedSize() requires IsHeapFree {
+        if constexpr(std::same_as<bool, Src>) {
+            return 5;
+        } else if constexpr(std::same_as<double, Src>) {
+            return DoubleFormat::MaxSize;
+        } else if constexpr(std::integral<Src>) {
+            return std::numeric_limits<Src>::digits10 + 1 + std::is_signed_v<Src>;
+        } else {
+            return 2 + 6 * std::tuple_size_v<Src> * sizeof(typename Src::value_type);
+        }
+    }
+
     operator Src&() {
         return content;
     }
@@ -197,6 +252,22 @@ public:
                 constexpr char v[] = "false";
                 return clb(v, sizeof(v)-1);
             }
+        } else if constexpr(d::StringTypeConcept<Src> && SerializerWriterConcept<std::decay_t<decltype(clb)>>) {
+            std::size_t size = content.size();
+            if constexpr(!d::DynamicStringTypeConcept<Src>) {
+                size = 0;
+                while(size < content.size () && content[size] != 0) size ++;
+            }
+            if(char v[] = "\""; !clb(v, sizeof(v)-1))  [[unlikely]] {
+                return false;
+            }
+            if(!d::writeEscapedString(reinterpret_cast<const char*>(content.data()), size * sizeof (typename Src::value_type), clb))  [[unlikely]] {
+                return false;
+            }
+            if(char v[] = "\""; !clb(v, sizeof(v)-1)) [[unlikely]] {
+                return false;
+            }
+            return true;
         } else if constexpr(d::StringTypeConcept<Src>) {
             if(char v[] = "\""; !clb(v, sizeof(v)-1))  [[unlikely]] {
                 return false;
@@ -230,13 +301,34 @@ public:
                 return false;
             }
             return true;
-        } else if constexpr(std::same_as<double, Src> || std::same_as<std::int64_t, Src>) {
+        } else if constexpr(std::integral<Src>) {
+            if constexpr(std::same_as<std::decay_t<decltype(clb)>, d::SizeCounter>) {
+                clb.commit(d::integerSize(content));
+                return true;
+            } else if constexpr(SerializerWriterConcept<std::decay_t<decltype(clb)>>) {
+                char * out = clb.reserve(24);
+                clb.commit(d::writeInteger(out, content) - out);
+                return true;
+            } else {
+                char buf[24];
+                return clb(buf, d::writeInteger(buf, content) - buf);
+            }
+        } else if constexpr(std::same_as<double, Src>) {
             if(std::isnan(content) || std::isinf(content)) {
                 char v[] = "0";
                 return clb(v, 1);
+            } else if constexpr(std::same_as<std::decay_t<decltype(clb)>, d::SizeCounter>
+                                && requires { DoubleFormat::serializedSize(content); }) {
+                clb.commit(DoubleFormat::serializedSize(content));
+                return true;
+            } else if constexpr(SerializerWriterConcept<std::decay_t<decltype(clb)>>) {
+                // formatters may overwrite up to 32 chars past the start
+                char * out = clb.reserve(50);
+                clb.commit(DoubleFormat::writeDouble(out, content) - out);
+                return true;
             } else {
                 char buf[50];
-                char * endChar = to_chars(buf, buf + sizeof (buf), content);
+                char * endChar = DoubleFormat::writeDouble(buf, content);
                 auto s = endChar-buf;
                 if(endChar-buf == sizeof (buf))  [[unlikely]] {
                     return false;
@@ -274,7 +366,9 @@ public:
                     ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
                     return false;
                 }
-                for(int i = 0; i < sz; i ++) {
+                if constexpr(d::isTrusted<InpIter>) {
+                    begin += sz;
+                } else for(int i = 0; i < sz; i ++) {
                     if(*begin != v[i]) [[unlikely]] {
                         ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - begin);
                         return false;
@@ -302,30 +396,44 @@ public:
             } else {
                 return true;
             }
-        } else if constexpr(std::same_as<double, Src> || std::same_as<std::int64_t, Src>) {
-             char buf[40];
-             std::size_t index = 0;
-             while(!d::isPlainEnd(*begin)) {
-                 if(begin == end ) [[unlikely]] {
-                     ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
-                     return false;
-                 }
-                 buf[index] = *begin;
-                 begin ++;
-                 index ++;
-                 if(index > sizeof (buf) - 1) [[unlikely]] {
-                     ctx.setError(DeserializationContext::ILLFORMED_NUMBER, end - begin);
-                     return false;
-                 }
-             }
-             buf[index] = 0;
-             double x;
-             if(fast_double_parser::parse_number(buf, &x) != nullptr) {
-                 content = x;
-                 return true;
-             }
-             ctx.setError(DeserializationContext::ILLFORMED_NUMBER, end - begin);
-             return false;
+        } else if constexpr(std::same_as<double, Src>) {
+            return deserializeDouble(begin, end, ctx, content);
+        } else if constexpr(std::integral<Src>) {
+            const char * numberBegin = std::to_address(begin);
+            const char * numberEnd = numberBegin;
+            switch(d::parseInteger<d::isPadded<InpIter>>(numberEnd, std::to_address(end), content)) {
+            case d::IntegerParseResult::OK:
+                begin += numberEnd - numberBegin;
+                if(begin == end) [[unlikely]] {
+                    ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
+                    return false;
+                }
+                if(!d::isTrusted<InpIter> && !d::isPlainEnd(*begin)) [[unlikely]] {
+                    ctx.setError(DeserializationContext::ILLFORMED_NUMBER, end - begin);
+                    return false;
+                }
+                return true;
+            case d::IntegerParseResult::NOT_INTEGER:
+            {
+                // fraction or exponent, like 1.5e3; truncated as before
+                double x;
+                if(!deserializeDouble(begin, end, ctx, x)) [[unlikely]] {
+                    return false;
+                }
+                if(!d::doubleFitsInteger<Src>(x)) [[unlikely]] {
+                    ctx.setError(DeserializationContext::INTEGER_OVERFLOW, end - begin);
+                    return false;
+                }
+                content = Src(x);
+                return true;
+            }
+            case d::IntegerParseResult::OUT_OF_RANGE:
+                ctx.setError(DeserializationContext::INTEGER_OVERFLOW, end - begin);
+                return false;
+            case d::IntegerParseResult::ILLFORMED:
+                ctx.setError(DeserializationContext::ILLFORMED_NUMBER, end - begin);
+                return false;
+            }
         }
         ctx.setError(DeserializationContext::INTERNAL_ERROR, end - begin);
         return false;
@@ -340,6 +448,13 @@ public:
     static constexpr auto FieldName = Str;
     static_assert(FieldName.check() == true, "Please, use printable chars in values keys");
 
+    static constexpr bool IsHeapFree = !d::DynamicContainerTypeConcept<Src> && d::FixedSizeContainerConcept<Src> && ItemType::IsHeapFree;
+
+    static constexpr std::size_t MaxSerializedSize() requires IsHeapFree {
+        constexpr std::size_t n = std::tuple_size_v<Src>;
+        return 2 + n * ItemType::MaxSerializedSize() + (n > 0 ? n - 1 : 0);
+    }
+
     Src& operator = (const Src& other) {
         return static_cast<Src &>(*this) = other;
     }
@@ -398,8 +513,8 @@ public:
                 if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
                     return false;
                 }
-                if(*begin == ',') {
-                    begin ++;
+                if(!d::skipValueSeparator(begin, end, ']', ctx)) [[unlikely]] {
+                    return false;
                 }
             }
         } else {
@@ -433,8 +548,8 @@ public:
                 if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
                     return false;
                 }
-                if(*begin == ',') {
-                    begin ++;
+                if(!d::skipValueSeparator(begin, end, ']', ctx)) [[unlikely]] {
+                    return false;
                 }
                 containerI ++;
             }
@@ -453,6 +568,8 @@ public:
     static constexpr auto FieldName = Str;
     static_assert(FieldName.check() == true, "Please, use printable chars in values keys");
 
+    static constexpr bool IsHeapFree = false;
+
     Src& operator = (const Src& other) {
         return static_cast<Src &>(*this) = other;
     }
@@ -534,8 +651,8 @@ public:
             if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
                 return false;
             }
-            if(*begin == ',') {
-                begin ++;
+            if(!d::skipValueSeparator(begin, end, '}', ctx)) [[unlikely]] {
+                return false;
             }
         }
         ctx.setError(DeserializationContext::INTERNAL_ERROR, end - begin);
@@ -547,12 +664,157 @@ namespace d {
 
 template <std::size_t Index, class PotentialJsonFieldT> struct KeyIndexEntry {
     static constexpr bool skip = true;
+    static constexpr bool isHeapFree = true;
 };
 template <std::size_t Index, JSONWrappedValueCompatible JsonFieldT>
 struct KeyIndexEntry<Index, JsonFieldT>{
     static constexpr bool skip = false;
     static constexpr auto FieldName =  JsonFieldT::FieldName;
     static constexpr std::size_t OriginalIndex = Index;
+    static constexpr bool isHeapFree = JsonFieldT::IsHeapFree;
+};
+
+template<class ForwardIt, class T, class Compare, class Proj>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp, Proj proj)
+{
+    ForwardIt it;
+    typename std::iterator_traits<ForwardIt>::difference_type count, step;
+    count = std::distance(first, last);
+
+    while (count > 0) {
+        it = first;
+        step = count / 2;
+        std::advance(it, step);
+        if (comp(proj(*it), value)) {
+            first = ++it;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+    return first;
+}
+
+template<std::forward_iterator I, std::sentinel_for<I> S, class T,
+         class Proj = std::identity,
+         std::indirect_strict_weak_order<
+             const T*,
+             std::projected<I, Proj>> Comp = std::ranges::less>
+constexpr I binary_search(I first, S last, const T& value, Comp comp = {}, Proj proj = {})
+{
+    first = lower_bound(first, last, value, comp, proj);
+    if (!(first == last) && !(comp(value, proj(*first)))) {
+        return first;
+    } else {
+        return last;
+    }
+}
+
+/*
+ * Perfect hash over the keys of one object type, found at compile time.
+ * The key length and up to MaxPositions key bytes, chosen to tell the keys apart, are packed
+ * into one integer, which is hashed with a single multiplication; so a lookup costs
+ * one hash and one memcmp. Positions count from the key beginning, or from its end
+ * if negative. If no collision-free parameters are found, found is false and
+ * the keys are looked up with binary search
+ */
+struct KeyHash {
+    static constexpr std::size_t MaxPositions = 4;
+    static constexpr int MaxFromBegin = 16;
+    static constexpr int MaxFromEnd = 8;
+    static constexpr std::size_t MultipliersCount = 256;
+
+    bool found = false;
+    std::uint8_t bits = 0;
+    std::uint8_t positionsCount = 0;
+    std::array<std::int8_t, MaxPositions> positions{};
+    std::uint64_t multiplier = 0;
+
+    static constexpr std::uint64_t byteAt(const char * key, std::size_t length, int position) {
+        if(position >= 0) {
+            return std::size_t(position) < length ? std::uint8_t(key[position]) : 0;
+        }
+        return std::size_t(-position) <= length ? std::uint8_t(key[length + position]) : 0;
+    }
+
+    constexpr std::uint64_t pack(const char * key, std::size_t length) const {
+        std::uint64_t x = length;
+        for(std::size_t i = 0; i < positionsCount; i ++) {
+            x = x << 8 | byteAt(key, length, positions[i]);
+        }
+        return x;
+    }
+
+    constexpr std::size_t operator()(const char * key, std::size_t length) const {
+        return (pack(key, length) * multiplier) >> (64 - bits);
+    }
+
+    template <std::size_t N>
+    constexpr std::size_t distinctPacks(const std::array<std::string_view, N> & keys) const {
+        std::array<std::uint64_t, N> packs;
+        for(std::size_t i = 0; i < N; i ++) {
+            packs[i] = pack(keys[i].data(), keys[i].size());
+        }
+        std::sort(packs.begin(), packs.end());
+        return std::unique(packs.begin(), packs.end()) - packs.begin();
+    }
+
+    template <std::size_t N>
+    constexpr bool isPerfect(const std::array<std::string_view, N> & keys) const {
+        std::array<std::uint64_t, (N * 16 + 63) / 64> used{};
+        for(const auto & k : keys) {
+            std::size_t slot = (*this)(k.data(), k.size());
+            if(used[slot / 64] & (std::uint64_t(1) << (slot % 64))) {
+                return false;
+            }
+            used[slot / 64] |= std::uint64_t(1) << (slot % 64);
+        }
+        return true;
+    }
+
+    template <std::size_t N>
+    static constexpr KeyHash find(const std::array<std::string_view, N> & keys) {
+        KeyHash h;
+        if constexpr (N != 0) {
+            // greedily add the byte positions which tell most of the keys apart
+            std::size_t distinct = h.distinctPacks(keys);
+            while(distinct < N && h.positionsCount < MaxPositions) {
+                KeyHash best = h;
+                std::size_t bestDistinct = distinct;
+                h.positionsCount ++;
+                for(int p = -MaxFromEnd; p < MaxFromBegin; p ++) {
+                    h.positions[h.positionsCount - 1] = std::int8_t(p);
+                    if(std::size_t d = h.distinctPacks(keys); d > bestDistinct) {
+                        best = h;
+                        bestDistinct = d;
+                    }
+                }
+                if(bestDistinct == distinct) {
+                    return KeyHash{};
+                }
+                h = best;
+                distinct = bestDistinct;
+            }
+            if(distinct < N) {
+                return KeyHash{};
+            }
+            std::uint8_t minBits = 1;
+            while((std::size_t(1) << minBits) < N) minBits ++;
+            // 1x..16x slots per key, the table stays small anyway
+            for(h.bits = minBits; h.bits <= minBits + 3; h.bits ++) {
+                std::uint64_t m = 0x9E3779B97F4A7C15ULL;
+                for(std::size_t attempt = 0; attempt < MultipliersCount; attempt ++) {
+                    h.multiplier = m | 1;
+                    if(h.isPerfect(keys)) {
+                        h.found = true;
+                        return h;
+                    }
+                    m = m * 6364136223846793005ULL + 1442695040888963407ULL;
+                }
+            }
+        }
+        return KeyHash{};
+    }
 };
 
 template <class T, class I> struct KeyIndexBuilder;
@@ -561,6 +823,7 @@ struct KeyIndexBuilder<std::tuple<FieldTypes...>, std::index_sequence<Is...>>  {
     using VarT = swl::variant<KeyIndexEntry<Is, FieldTypes>...>;
 
     static constexpr std::size_t jsonFieldsCount = (0 + ... + (KeyIndexEntry<Is, FieldTypes>::skip ? 0: 1));
+    static constexpr bool isHeapFree = (true && ... && KeyIndexEntry<Is, FieldTypes>::isHeapFree);
     using KeyIndexEntryArrayType = std::array<VarT, jsonFieldsCount>;
 
     struct visitor {
@@ -593,43 +856,169 @@ struct KeyIndexBuilder<std::tuple<FieldTypes...>, std::index_sequence<Is...>>  {
         return ret;
     }
     static constexpr KeyIndexEntryArrayType sortedKeyIndexArray = sortKeyIndexes({KeyIndexEntry<Is, FieldTypes>()...});
-};
 
-template<class ForwardIt, class T, class Compare, class Proj>
-ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp, Proj proj)
-{
-    ForwardIt it;
-    typename std::iterator_traits<ForwardIt>::difference_type count, step;
-    count = std::distance(first, last);
+    static constexpr std::array<std::string_view, jsonFieldsCount> makeSortedKeys() {
+        std::array<std::string_view, jsonFieldsCount> ret;
+        for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+            ret[i] = ProjKeyIndexVariantToStringView{}(sortedKeyIndexArray[i]);
+        }
+        return ret;
+    }
+    static constexpr std::array<std::string_view, jsonFieldsCount> sortedKeys = makeSortedKeys();
+
+    // Struct field index for every sorted key
+    static constexpr std::array<std::size_t, jsonFieldsCount> makeSortedOriginalIndexes() {
+        std::array<std::size_t, jsonFieldsCount> ret{};
+        for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+            ret[i] = swl::visit([]<class KeyIndexType>(KeyIndexType) -> std::size_t {
+                if constexpr(KeyIndexType::skip == false) {
+                    return KeyIndexType::OriginalIndex;
+                } else
+                    return 0;
+            }, sortedKeyIndexArray[i]);
+        }
+        return ret;
+    }
+    static constexpr std::array<std::size_t, jsonFieldsCount> sortedOriginalIndexes = makeSortedOriginalIndexes();
+
+    // Declaration order of the keys, which is the order most of the producers write them in
+    static constexpr std::array<std::size_t, jsonFieldsCount> makeSortedToDeclared() {
+        std::array<std::size_t, jsonFieldsCount> ret{};
+        for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+            for(std::size_t j = 0; j < jsonFieldsCount; j ++) {
+                ret[i] += sortedOriginalIndexes[j] < sortedOriginalIndexes[i];
+            }
+        }
+        return ret;
+    }
+    static constexpr std::array<std::size_t, jsonFieldsCount> sortedToDeclared = makeSortedToDeclared();
+    static constexpr std::array<std::size_t, jsonFieldsCount> makeDeclaredToSorted() {
+        std::array<std::size_t, jsonFieldsCount> ret{};
+        for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+            ret[sortedToDeclared[i]] = i;
+        }
+        return ret;
+    }
+    static constexpr std::array<std::size_t, jsonFieldsCount> declaredToSorted = makeDeclaredToSorted();
 
-    while (count > 0) {
-        it = first;
-        step = count / 2;
-        std::advance(it, step);
-        if (comp(proj(*it), value)) {
-            first = ++it;
-            count -= step + 1;
+    // What is written before every field value: {"first": for the first field, ,"name": for the rest
+    static constexpr std::size_t fieldPrefixesLength = [] {
+        std::size_t ret = 0;
+        for(const auto & k : sortedKeys) {
+            ret += k.size() + 4;
         }
-        else
-            count = step;
+        return ret;
+    }();
+    struct FieldPrefixes {
+        std::array<char, fieldPrefixesLength> chars{};
+        // indexed by the struct field index
+        std::array<std::size_t, sizeof... (Is)> offsets{};
+        std::array<std::size_t, sizeof... (Is)> lengths{};
+    };
+    static constexpr FieldPrefixes makeFieldPrefixes() {
+        FieldPrefixes ret;
+        std::size_t pos = 0;
+        for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+            const std::size_t sortedIndex = declaredToSorted[i];
+            const std::size_t originalIndex = sortedOriginalIndexes[sortedIndex];
+            ret.offsets[originalIndex] = pos;
+            ret.lengths[originalIndex] = sortedKeys[sortedIndex].size() + 4;
+            ret.chars[pos ++] = i == 0 ? '{' : ',';
+            ret.chars[pos ++] = '"';
+            for(char c : sortedKeys[sortedIndex]) {
+                ret.chars[pos ++] = c;
+            }
+            ret.chars[pos ++] = '"';
+            ret.chars[pos ++] = ':';
+        }
+        return ret;
+    }
+    static constexpr FieldPrefixes fieldPrefixes = makeFieldPrefixes();
+
+    static constexpr KeyHash keyHash = KeyHash::find(sortedKeys);
+
+    // slot -> index in sortedKeyIndexArray + 1, 0 for empty slots
+    using KeyHashSlotType = std::conditional_t<(jsonFieldsCount < 255), std::uint8_t, std::uint16_t>;
+    static constexpr std::size_t keyHashTableSize = keyHash.found ? std::size_t(1) << keyHash.bits : 0;
+    static constexpr std::array<KeyHashSlotType, keyHashTableSize> makeKeyHashTable() {
+        std::array<KeyHashSlotType, keyHashTableSize> ret{};
+        if constexpr (keyHashTableSize != 0) {
+            for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+                ret[keyHash(sortedKeys[i].data(), sortedKeys[i].size())] = KeyHashSlotType(i + 1);
+            }
+        }
+        return ret;
+    }
+    static constexpr std::array<KeyHashSlotType, keyHashTableSize> keyHashTable = makeKeyHashTable();
+
+    // Like findKey, but checks the key expected next in declaration order first;
+    // expectedKey is the declaration order position, moved past the found key
+    static std::size_t findKeyInOrder(std::string_view key, std::size_t & expectedKey, DeserializationContext & ctx) {
+        if(expectedKey < jsonFieldsCount && key == sortedKeys[declaredToSorted[expectedKey]]) [[likely]] {
+            ctx.countKeyMatch(&DeserializationContext::KeyMatchStats::predicted);
+            return declaredToSorted[expectedKey ++];
+        }
+        std::size_t i = findKey(key);
+        if(i != jsonFieldsCount) {
+            ctx.countKeyMatch(&DeserializationContext::KeyMatchStats::lookedUp);
+            expectedKey = sortedToDeclared[i] + 1;
+        } else {
+            ctx.countKeyMatch(&DeserializationContext::KeyMatchStats::unknown);
+        }
+        return i;
     }
-    return first;
-}
 
-template<std::forward_iterator I, std::sentinel_for<I> S, class T,
-         class Proj = std::identity,
-         std::indirect_strict_weak_order<
-             const T*,
-             std::projected<I, Proj>> Comp = std::ranges::less>
-constexpr I binary_search(I first, S last, const T& value, Comp comp = {}, Proj proj = {})
-{
-    first = lower_bound(first, last, value, comp, proj);
-    if (!(first == last) && !(comp(value, proj(*first)))) {
-        return first;
-    } else {
-        return last;
+    // Order of the keys in the previous object, as indexes in sortedKeyIndexArray
+    using SortedIndexType = std::conditional_t<(jsonFieldsCount <= 256), std::uint8_t, std::uint16_t>;
+    struct KeyOrder {
+        std::array<SortedIndexType, jsonFieldsCount> sortedIndexes;
+    };
+    static constexpr KeyOrder makeDeclaredKeyOrder() {
+        KeyOrder ret{};
+        for(std::size_t i = 0; i < jsonFieldsCount; i ++) {
+            ret.sortedIndexes[i] = SortedIndexType(declaredToSorted[i]);
+        }
+        return ret;
     }
-}
+    static constexpr KeyOrder declaredKeyOrder = makeDeclaredKeyOrder();
+
+    // Like findKeyInOrder, but predicts keys from the order learned on the previous objects;
+    // the key found at position replaces the prediction for the next object
+    static std::size_t findKeyLearned(std::string_view key, std::size_t & position, KeyOrder & order, DeserializationContext & ctx) {
+        if(position < jsonFieldsCount) [[likely]] {
+            std::size_t predicted = order.sortedIndexes[position];
+            if(key == sortedKeys[predicted]) [[likely]] {
+                ctx.countKeyMatch(&DeserializationContext::KeyMatchStats::predicted);
+                position ++;
+                return predicted;
+            }
+        }
+        std::size_t i = findKey(key);
+        if(i != jsonFieldsCount) {
+            ctx.countKeyMatch(&DeserializationContext::KeyMatchStats::lookedUp);
+            if(position < jsonFieldsCount) {
+                order.sortedIndexes[position ++] = SortedIndexType(i);
+            }
+        } else {
+            ctx.countKeyMatch(&DeserializationContext::KeyMatchStats::unknown);
+        }
+        return i;
+    }
+
+    // Index in sortedKeyIndexArray, or jsonFieldsCount if there is no such key
+    static std::size_t findKey(std::string_view key) {
+        if constexpr (keyHash.found) {
+            std::size_t i = keyHashTable[keyHash(key.data(), key.size())];
+            if(i != 0 && sortedKeys[i - 1].size() == key.size() && std::memcmp(sortedKeys[i - 1].data(), key.data(), key.size()) == 0) {
+                return i - 1;
+            }
+            return jsonFieldsCount;
+        } else {
+            return d::binary_search(sortedKeys.begin(), sortedKeys.end(), key) - sortedKeys.begin();
+        }
+    }
+};
+
 }
 
 template <d::JSONObjectValue Src, d::ConstString Str>
@@ -638,13 +1027,105 @@ class J<Src, Str> : public Src {
     static constexpr auto sortedKeyIndexArray = KeyIndexBuilderT::sortedKeyIndexArray;
 
     using FilledFlagsArray = std::array<bool, sortedKeyIndexArray.size()>;
+
+    using KeyOrder = typename KeyIndexBuilderT::KeyOrder;
+    // no heap and no sharing between threads, starts from the declaration order
+    static inline thread_local KeyOrder learnedKeyOrder = KeyIndexBuilderT::declaredKeyOrder;
+
+    // Field handlers, indexed by the sorted key position: one table lookup and one call
+    // per field instead of a visit over all the fields
+    template <std::size_t OriginalIndex, class InpIter>
+    static bool deserializeField(Src & obj, InpIter & begin, const InpIter & end, DeserializationContext & ctx) {
+        return pfr::get<OriginalIndex>(obj).DeserializeInternal(begin, end, ctx);
+    }
+    template <std::size_t OriginalIndex>
+    static void resetField(Src & obj) {
+        using FieldType = pfr::tuple_element_t<OriginalIndex, Src>;
+        pfr::get<OriginalIndex>(obj) = FieldType{};
+    }
+
+    template <class InpIter>
+    using FieldDeserializerT = bool (*)(Src &, InpIter &, const InpIter &, DeserializationContext &);
+    template <class InpIter>
+    static constexpr auto fieldDeserializers = []<std::size_t ... Is>(std::index_sequence<Is...>) {
+        return std::array<FieldDeserializerT<InpIter>, sizeof...(Is)>{&deserializeField<KeyIndexBuilderT::sortedOriginalIndexes[Is], InpIter>...};
+    }(std::make_index_sequence<sortedKeyIndexArray.size()>{});
+
+    static constexpr auto fieldResetters = []<std::size_t ... Is>(std::index_sequence<Is...>) {
+        return std::array<void (*)(Src &), sizeof...(Is)>{&resetField<KeyIndexBuilderT::sortedOriginalIndexes[Is]>...};
+    }(std::make_index_sequence<sortedKeyIndexArray.size()>{});
+
+    template <std::size_t Index>
+    bool serializeField(SerializerOutputCallbackConcept auto && clb) const {
+        using FieldType = pfr::tuple_element_t<Index, Src>;
+        if constexpr(d::JSONWrappedValueCompatible<FieldType>) {
+            constexpr auto & prefixes = KeyIndexBuilderT::fieldPrefixes;
+            if(!clb(prefixes.chars.data() + prefixes.offsets[Index], prefixes.lengths[Index])) [[unlikely]] {
+                return false;
+            }
+            return pfr::get<Index>(static_cast<const Src &>(*this)).SerializeInternal(std::forward<std::decay_t<decltype(clb)>>(clb));
+        } else {
+            return true;
+        }
+    }
+
+    template <std::size_t Index>
+    static constexpr std::size_t maxFieldSize() {
+        using FieldType = pfr::tuple_element_t<Index, Src>;
+        if constexpr(d::JSONWrappedValueCompatible<FieldType>) {
+            return FieldType::MaxSerializedSize();
+        } else {
+            return 0;
+        }
+    }
+
+    template<class InpIter> requires InputIteratorConcept<InpIter>
+    void deserializeRange(InpIter b, const InpIter & e, DeserializationContext & ctx) {
+        if(!DeserializeInternal(b, e, ctx)) {
+            return;
+        }
+        if constexpr(d::isStrict<InpIter>) {
+            while(b != e && d::isSpace(*b)) {
+                b ++;
+            }
+            if(b != e) [[unlikely]] {
+                ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, e - b);
+            }
+        }
+    }
+
+    template <bool Padded, d::Validation V>
+    void deserializeRaw(const char * data, std::size_t size, DeserializationContext & ctx) {
+        deserializeRange(d::RawInputIterator<Padded, V>(data), d::RawInputIterator<Padded, V>(data + size), ctx);
+    }
+
+    template <d::Validation V>
+    void deserializeIndexed(const char * data, std::size_t size, const StructuralIndex & index, DeserializationContext & ctx) {
+        d::StructuralCursor cursor(index);
+        deserializeRange(d::IndexedInputIterator<V>(data, &cursor), d::IndexedInputIterator<V>(data + size, &cursor), ctx);
+    }
+
+    template <bool Padded>
+    bool deserializeValidated(const char * data, std::size_t size, DeserializationContext & ctx) {
+        if(ctx.flag(ParseFlags::STRICT)) {
+            deserializeRaw<Padded, d::Validation::STRICT>(data, size, ctx);
+        } else if(ctx.flag(ParseFlags::TRUSTED_INPUT)) {
+            deserializeRaw<Padded, d::Validation::TRUSTED>(data, size, ctx);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
     template<class InpIter> requires InputIteratorConcept<InpIter>
-    bool DeserialiseField(const InpIter & keyBegin, const InpIter & keyEnd, InpIter &begin, const InpIter & end, DeserializationContext & ctx, bool fieldisNull, FilledFlagsArray & filledFlagsArray) {
+    bool DeserialiseField(const InpIter & keyBegin, const InpIter & keyEnd, InpIter &begin, const InpIter & end, DeserializationContext & ctx, bool fieldisNull, FilledFlagsArray & filledFlagsArray, std::size_t & expectedKey, KeyOrder * learnedOrder) {
         std::string_view keySV{keyBegin, keyEnd};
 
-        auto foundVarIt = d::binary_search(sortedKeyIndexArray.begin(), sortedKeyIndexArray.end(), keySV, std::ranges::less{}, typename KeyIndexBuilderT::ProjKeyIndexVariantToStringView{});
+        const std::size_t foundIndex = learnedOrder != nullptr
+                ? KeyIndexBuilderT::findKeyLearned(keySV, expectedKey, *learnedOrder, ctx)
+                : KeyIndexBuilderT::findKeyInOrder(keySV, expectedKey, ctx);
 
-        if(foundVarIt == sortedKeyIndexArray.end()) {
+        if(foundIndex == sortedKeyIndexArray.size()) {
             if(ctx.flag(ParseFlags::EXCESS_FIELDS_PROHIBITED)) {
                 ctx.setError(DeserializationContext::EXCESS_FIELD, end - begin);
                 return false;
@@ -658,23 +1139,14 @@ class J<Src, Str> : public Src {
         }
 
 
-        bool deserRes = swl::visit(
-                [this, &begin, &end, &ctx, fieldisNull]<class KeyIndexType>(KeyIndexType keyIndex) -> bool{
-                    if constexpr(KeyIndexType::skip == false) {
-                        using FieldType = pfr::tuple_element_t<KeyIndexType::OriginalIndex, Src>;
-                        FieldType & f = pfr::get<KeyIndexType::OriginalIndex>(static_cast<Src &>(*this));
-                        if(fieldisNull) {
-                            f = FieldType{};
-                            return true;
-                        }  else {
-                            return f.DeserializeInternal(begin, end, ctx);
-                        }
-                    } else
-                        return false;
-                }
-        , *foundVarIt);
+        bool deserRes = true;
+        if(fieldisNull) {
+            fieldResetters[foundIndex](*this);
+        } else {
+            deserRes = fieldDeserializers<InpIter>[foundIndex](*this, begin, end, ctx);
+        }
         if(deserRes) {
-            filledFlagsArray[foundVarIt-sortedKeyIndexArray.begin()] = true;
+            filledFlagsArray[foundIndex] = true;
         }
 
         return deserRes;
@@ -684,6 +1156,20 @@ public:
     static constexpr auto FieldName = Str;
     static_assert(FieldName.check() == true, "Please, use printable chars in values keys");
 
+    // No dynamic containers in any of the JSON fields
+    static constexpr bool IsHeapFree = KeyIndexBuilderT::isHeapFree;
+
+    // Worst-case output size for heap-free models: the field prefixes, the widest values and '}'
+    static constexpr std::size_t MaxSerializedSize() requires IsHeapFree {
+        if constexpr(sortedKeyIndexArray.size() == 0) {
+            return 2;
+        } else {
+            return KeyIndexBuilderT::fieldPrefixesLength + 1 + []<std::size_t ... Is>(std::index_sequence<Is...>) {
+                return (std::size_t(0) + ... + maxFieldSize<Is>());
+            }(std::make_index_sequence<pfr::tuple_size_v<Src>>{});
+        }
+    }
+
     J(const Src & other): Src(other) {}
     J() = default;
 
@@ -692,67 +1178,75 @@ public:
     }
 
     bool SerializeInternal(SerializerOutputCallbackConcept auto && clb) const {
-        std::size_t last_index = 0;
-        pfr::for_each_field(static_cast<const Src &>(*this), [&last_index]<class T>(const T & val, std::size_t index){
-            if constexpr(d::JSONWrappedValueCompatible<T>) { last_index = index;}
-        });
-        if(char v[] = "{"; !clb(v, sizeof(v)-1)) {
-            return false;
-        }
-        bool r = true;
-        auto visitor = [&clb, last_index, &r]<class T>(const T & val, std::size_t index) {
-            if(!r) return;
-            if constexpr(d::JSONWrappedValueCompatible<T>) {
-                if(char v[] = "\""; !clb(v, sizeof(v)-1))[[unlikely]]   {
-                    r = false;
-                    return;
-                }
-                if(!clb(reinterpret_cast<const char*>(val.FieldName.m_data), val.FieldName.Length * val.FieldName.CharSize)) {
-                    r = false;
-                    return;
-                }
-                if(char v[] = "\":"; !clb(v,  sizeof(v)-1)) [[unlikely]] {
-                    r = false;
-                    return;
-                }
-                if(!val.SerializeInternal(std::forward<std::decay_t<decltype(clb)>>(clb)))[[unlikely]]  {
-                    r = false;
-                    return;
-                }
-                if(index != last_index) {
-                    if(char v[] = ","; !clb(v, sizeof(v)-1)) [[unlikely]] {
-                        r = false;
-                        return;
-                    }
-                }
+        if constexpr(sortedKeyIndexArray.size() == 0) {
+            char v[] = "{}";
+            return clb(v, sizeof(v)-1);
+        } else {
+            // one call for the separator and the key, one for the value
+            bool r = [this, &clb]<std::size_t ... Is>(std::index_sequence<Is...>) {
+                return (serializeField<Is>(std::forward<std::decay_t<decltype(clb)>>(clb)) && ...);
+            }(std::make_index_sequence<pfr::tuple_size_v<Src>>{});
+            if(!r) [[unlikely]]  {
+                return false;
             }
-        };
-        pfr::for_each_field(static_cast<const Src &>(*this), visitor);
-        if(!r) [[unlikely]]  {
-            return false;
-        }
-        if(char v[] = "}"; !clb(v, sizeof(v)-1)) [[unlikely]] {
-            return false;
+            if(char v[] = "}"; !clb(v, sizeof(v)-1)) [[unlikely]] {
+                return false;
+            }
+            return true;
         }
-        return true;
     }
 
     template <class T>
         requires (!SerializerOutputCallbackConcept<T>)
     bool Serialize(T & container) const {
-        return SerializeInternal([&container](const char * data, std::size_t size){
-            container.insert(container.end(), data, data + size);
-            return true;
-        });
+        if constexpr(ResizableCharContainerConcept<T>) {
+            ContainerWriter<T> writer(container);
+            return SerializeInternal(writer);
+        } else {
+            return SerializeInternal([&container](const char * data, std::size_t size){
+                container.insert(container.end(), data, data + size);
+                return true;
+            });
+        }
     }
     bool Serialize(SerializerOutputCallbackConcept auto && clb) const {
         return SerializeInternal(std::forward<std::decay_t<decltype(clb)>>(clb));
     }
 
+    // Exact size of the serialized output, with nothing written
+    std::size_t SerializedSize() const {
+        d::SizeCounter counter;
+        SerializeInternal(counter);
+        return counter.size();
+    }
+
+    // Appends to container with a single resize, sized by SerializedSize()
+    template <ResizableCharContainerConcept T>
+    bool Serialize(T & container, ExactSizeT) const {
+        const std::size_t start = container.size();
+        container.resize(start + SerializedSize() + d::UncheckedWriter::Slack);
+        d::UncheckedWriter writer(container.data() + start);
+        bool ret = SerializeInternal(writer);
+        container.resize(start + writer.size());
+        return ret;
+    }
+
+    // Heap-free models only: writes into a fixed buffer with no bounds checks at all
+    template <std::size_t N>
+    bool Serialize(std::array<char, N> & buffer, std::size_t & size) const requires IsHeapFree {
+        static_assert(N >= MaxSerializedSize() + UncheckedSlack, "JSONReflection: the buffer should have MaxSerializedSize() + UncheckedSlack chars");
+        d::UncheckedWriter writer(buffer.data());
+        bool ret = SerializeInternal(writer);
+        size = writer.size();
+        return ret;
+    }
+
     template<class InpIter> requires InputIteratorConcept<InpIter>
     DeserializationContext Deserialize(InpIter begin, const InpIter & end, ParseFlags flags = ParseFlags::DEFAULT) {
         DeserializationContext ctx(end-begin, flags);
-        bool ret = DeserializeInternal(begin, end, ctx);
+        if(!deserializeValidated<false>(std::to_address(begin), end - begin, ctx)) {
+            bool ret = DeserializeInternal(begin, end, ctx);
+        }
         return ctx;
     }
 
@@ -760,10 +1254,50 @@ public:
     DeserializationContext Deserialize(const ContainterT & c, ParseFlags flags = ParseFlags::DEFAULT) {
         DeserializationContext ctx(c.size(), flags);
         auto b = c.begin();
-        bool ret =  DeserializeInternal(b, c.end(), ctx);
+        if(!deserializeValidated<false>(std::to_address(b), c.size(), ctx)) {
+            bool ret =  DeserializeInternal(b, c.end(), ctx);
+        }
+        return ctx;
+    }
+
+    // data[size] should be zero and DeserializePadding bytes past data + size readable,
+    // like in a buffer resized to size + DeserializePadding. Tokens are scanned with no end checks,
+    // the zero stops them, so input with anything else at data[size] is rejected
+    DeserializationContext DeserializePadded(const char * data, std::size_t size, ParseFlags flags = ParseFlags::DEFAULT) {
+        DeserializationContext ctx(size, flags);
+        if(data[size] != '\0') [[unlikely]] {
+            ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, 0);
+        } else if(!deserializeValidated<true>(data, size, ctx)) {
+            deserializeRaw<true, d::Validation::REGULAR>(data, size, ctx);
+        }
+        return ctx;
+    }
+
+    // Two passes: the structural index of the input is built first (see StructuralIndex), then
+    // parsers jump between its entries. Skipped arrays and objects are checked for balanced
+    // brackets only, unless STRICT. Pays off for large documents with a lot of skipped data
+    template<class ContainterT> requires std::ranges::contiguous_range<ContainterT>
+    DeserializationContext DeserializeIndexed(const ContainterT & c, StructuralIndex & index, ParseFlags flags = ParseFlags::DEFAULT) {
+        const char * data = std::ranges::data(c);
+        std::size_t size = std::ranges::size(c);
+        DeserializationContext ctx(size, flags);
+        index.build(data, size);
+        if(ctx.flag(ParseFlags::STRICT)) {
+            deserializeIndexed<d::Validation::STRICT>(data, size, index, ctx);
+        } else if(ctx.flag(ParseFlags::TRUSTED_INPUT)) {
+            deserializeIndexed<d::Validation::TRUSTED>(data, size, index, ctx);
+        } else {
+            deserializeIndexed<d::Validation::REGULAR>(data, size, index, ctx);
+        }
         return ctx;
     }
 
+    template<class ContainterT> requires std::ranges::contiguous_range<ContainterT>
+    DeserializationContext DeserializeIndexed(const ContainterT & c, ParseFlags flags = ParseFlags::DEFAULT) {
+        StructuralIndex index;
+        return DeserializeIndexed(c, index, flags);
+    }
+
     template<class InpIter> requires InputIteratorConcept<InpIter>
     bool DeserializeInternal(InpIter & begin, const InpIter & end, DeserializationContext & ctx) {
         if(!d::skipWhiteSpaceTill(begin, end, '{', ctx)) [[unlikely]] {
@@ -772,6 +1306,8 @@ public:
 
         FilledFlagsArray filledFlags;
         filledFlags.fill(false);
+        std::size_t expectedKey = 0;
+        KeyOrder * learnedOrder = ctx.flag(ParseFlags::LEARN_KEY_ORDER) ? &learnedKeyOrder : nullptr;
         while(begin != end) {
             if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
                 return false;
@@ -785,15 +1321,7 @@ public:
                             ctx.setError(DeserializationContext::MISSING_FIELD, end - begin);
                             return false;
                         } else {
-                            swl::visit([this]<class KeyIndexType>(KeyIndexType keyIndex){
-                                   if constexpr(KeyIndexType::skip == false) {
-                                       using FieldType = pfr::tuple_element_t<KeyIndexType::OriginalIndex, Src>;
-                                       FieldType & f = pfr::get<KeyIndexType::OriginalIndex>(static_cast<Src &>(*this));
-                                       f = FieldType{};
-
-                                   }
-                               }
-                            , *(sortedKeyIndexArray.begin() + i));
+                            fieldResetters[i](*this);
                         }
                     }
                 }
@@ -826,15 +1354,15 @@ public:
                 begin += 4;
                 fieldisNull = true;
             }
-            if(!DeserialiseField(keyBegin, keyEnd, begin, end, ctx, fieldisNull, filledFlags)) {
+            if(!DeserialiseField(keyBegin, keyEnd, begin, end, ctx, fieldisNull, filledFlags, expectedKey, learnedOrder)) {
                 return false;
             }
 
             if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
                 return false;
             }
-            if(*begin == ',') {
-                begin ++;
+            if(!d::skipValueSeparator(begin, end, '}', ctx)) [[unlikely]] {
+                return false;
             }
         }
         ctx.setError(DeserializationContext::INTERNAL_ERROR, end - begin);
@@ -843,5 +1371,12 @@ public:
 };
 
 
+// static_assert(IsHeapFree<Model>): Model has no dynamic containers, so J<Model>::MaxSerializedSize()
+// is known at compile time. Accepts both J<Model> and Model
+template <class T>
+inline constexpr bool IsHeapFree = J<T>::IsHeapFree;
+template <d::JSONWrappedValueCompatible T>
+inline constexpr bool IsHeapFree<T> = T::IsHeapFree;
+
 }
 #endif // CPP_JSON_REFLECTION_HPP
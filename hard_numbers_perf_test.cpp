@@ -0,0 +1,83 @@
+#include "cpp_json_reflection.hpp"
+#include "test_utils.hpp"
+
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using JSONReflection::J;
+using std::vector, std::string;
+
+namespace HardNumbers {
+struct Root_ {
+    J<vector<J<double>>, "numbers"> numbers;
+};
+using Root = J<Root_>;
+
+/*
+ * Numbers which miss the Eisel-Lemire fast path or sit right on its edges:
+ * 17 significant digits (sensor feeds), more than 19 digits, exact halfway points
+ * printed with hundreds of digits, subnormals and the ends of the exponent range
+ */
+string makeCorpus(std::size_t count) {
+    std::mt19937_64 rng(2021);
+    auto randomDouble = [&rng](bool subnormal) {
+        std::uint64_t bits = rng() & 0x7FFFFFFFFFFFFFFFULL;
+        if(subnormal) {
+            bits &= 0x000FFFFFFFFFFFFFULL;
+        }
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return std::isfinite(v) ? v : 1.0;
+    };
+    string out = "{\"numbers\": [";
+    vector<char> buf(1024);
+    for(std::size_t i = 0; i < count; i ++) {
+        int n = 0;
+        switch(i % 5) {
+        case 0: n = std::snprintf(buf.data(), buf.size(), "%.17g", randomDouble(false) * (rng() % 2 ? 1 : -1)); break;
+        case 1: n = std::snprintf(buf.data(), buf.size(), "%.24e", randomDouble(false)); break;
+        case 2: {
+            double v = randomDouble(false);
+            long double halfway = (static_cast<long double>(v) + std::nextafter(v, INFINITY)) / 2;
+            n = std::snprintf(buf.data(), buf.size(), "%.*Le", int(20 + rng() % 700), halfway);
+            break;
+        }
+        case 3: n = std::snprintf(buf.data(), buf.size(), "%.17g", randomDouble(true)); break;
+        case 4: n = std::snprintf(buf.data(), buf.size(), "%.17ge%d", 1.0 + double(rng() % 1000000) / 1e6, int(rng() % 19) + 289); break;
+        }
+        if(i != 0) {
+            out += ",";
+        }
+        out.append(buf.data(), n);
+    }
+    out += "]}";
+    return out;
+}
+}
+
+int hardNumbersPerfTest() {
+    string inp = HardNumbers::makeCorpus(100000);
+    std::cout << "inp.size " << inp.size() << std::endl;
+
+    HardNumbers::Root root;
+    if(!root.Deserialize(inp)) throw 1;
+
+    // every value must be the correctly rounded one
+    const char * p = inp.data() + inp.find('[') + 1;
+    for(const auto & v : root.numbers) {
+        char * next;
+        double expected = std::strtod(p, &next);
+        if(std::memcmp(&expected, &static_cast<const double &>(v), sizeof(double)) != 0) throw 1;
+        p = next + 1;
+    }
+
+    bool res;
+    doPerformanceTest("hard numbers parsing", 20, [&res, &root, &inp]{
+        res = root.Deserialize(inp);
+        if(!res) throw 1;
+    });
+    return 0;
+}
@@ -43,7 +43,7 @@ struct CustomDateString {
     using DeserializeContainerT = string;
     static_assert (JSONReflection::StringOutputContainerConcept<DeserializeContainerT>);
     bool JSONDeserialise(DeserializeContainerT & cont) {
-        char v[] = "2021-10\\n-24T11:25:29Z";
+        char v[] = "2021-10\n-24T11:25:29Z";
         auto r = memcmp(v, & *cont.begin(), sizeof(v)-1);
 
         return r == 0;
@@ -69,25 +69,348 @@ struct RootObject_ {
 };
 
 using RootObject = J<RootObject_>;
+
+struct Position_ {
+    J<double, "lat", JSONReflection::Precision<7>>         lat;
+    J<double, "lon", JSONReflection::Precision<7>>         lon;
+    J<double, "alt", JSONReflection::SignificantDigits<3>> alt;
+};
+using Position = J<Position_>;
+
+struct Telemetry_ {
+    J<array<char, 15>,           "id">        id;
+    J<int32_t,                   "seq">       seq;
+    J<bool,                      "ok">        ok;
+    J<array<Position, 2>,        "track">     track;
+    int                                       notJSON;
+};
+using Telemetry = J<Telemetry_>;
+
+struct Record_ {
+    J<int64_t,            "id">    id;
+    J<string,             "name">  name;
+    J<double,             "score"> score;
+    J<bool,               "ok">    ok;
+    J<vector<J<int64_t>>, "tags">  tags;
+};
+
+struct RecordList_ {
+    J<vector<J<Record_>>, "records"> records;
+};
+using RecordList = J<RecordList_>;
+
+struct SizeEdges_ {
+    J<string,             "text">    text;
+    J<vector<J<int64_t>>, "ints">    ints;
+    J<uint64_t,           "u64">     u64;
+    J<int32_t,            "i32">     i32;
+    J<vector<J<double>>,  "doubles"> doubles;
+    J<vector<Position>,   "track">   track;
+};
+using SizeEdges = J<SizeEdges_>;
+static_assert(JSONReflection::IsHeapFree<Telemetry_> && !JSONReflection::IsHeapFree<InnerStruct2> && !RootObject::IsHeapFree);
+static_assert(Position::MaxSerializedSize() == 3 * 7 + 25 + 25 + 24 + 1);
+static_assert(Telemetry::MaxSerializedSize() == (6 + 2 + 6 * 15) + (7 + 11) + (6 + 5) + (9 + 2 + 2 * Position::MaxSerializedSize() + 1) + 1);
 }
 
 //using TestInline = J
 int canadaJsonPerfTest();
 int twitterJsonPerfTest();
+int hardNumbersPerfTest();
 
+// SerializedSize() is exact and Serialize(container, ExactSize) appends what Serialize(container) writes
+template <class T>
+void checkExactSize(const T & v) {
+    std::string out, exact = "prefix";
+    if(!v.Serialize(out) || v.SerializedSize() != out.size() || !v.Serialize(exact, JSONReflection::ExactSize) || exact != "prefix" + out) {
+        throw 1;
+    }
+}
 
 int main()
 {
     {
         char inp[] = "  \"blabla\\nfuu\\u03FF \"  ";
         std::array<char, 30> output;
-        JSONReflection::DeserializationResult ctx(sizeof (inp)-1);
+        JSONReflection::DeserializationContext ctx(sizeof (inp)-1);
         char * i = inp;
         bool r = JSONReflection::d::extractJSString(i, inp+sizeof (inp)-1, ctx, output);
         r = false;
     }
+    {
+        TestFeatures::RootObject t;
+        std::string inp = R"({"a": 9007199254740993, "ints_array": [-9223372036854775808, 0, 1, 2, 9223372036854775807]})";
+        if(!t.Deserialize(inp) || t.a != 9007199254740993 || t.ints_array[0] != std::numeric_limits<int64_t>::min()) {
+            throw 1;
+        }
+    }
+    {
+        TestFeatures::Position p;
+        p.lat = 43.420273000000009;
+        p.lon = -65.61361699999997;
+        p.alt = 1234.5;
+        std::string out;
+        if(!p.Serialize(out) || out != R"({"lat":43.420273,"lon":-65.613617,"alt":1230})") {
+            throw 1;
+        }
+    }
+    {
+        // a learned key order, replaced in place as the order changes, parses like the declared one
+        std::string inp = R"({"records": [)";
+        for(int i = 0; i < 12; i ++) {
+            std::string id = std::to_string(i), tags = "[" + id + ", -" + id + "]";
+            if(i < 3) {
+                inp += R"({"id": )" + id + R"(, "name": "n)" + id + R"(", "score": )" + id + R"(.5, "ok": true, "tags": )" + tags + "}";
+            } else if(i < 7 || i >= 9) {
+                inp += R"({"tags": )" + tags + R"(, "ok": false, "extra": {"id": 1, "x": [1]}, "id": )" + id + R"(, "score": -)" + id + R"(e2, "name": "m)" + id + "\"}";
+            } else {
+                inp += R"({"score": )" + id + R"(, "unknown": null, "id": )" + id + R"(, "name": "k)" + id + "\"}";
+            }
+            inp += i < 11 ? ", " : "]}";
+        }
+        TestFeatures::RecordList plain, learned;
+        std::string plainOut, learnedOut;
+        auto plainCtx = plain.Deserialize(inp);
+        if(!plainCtx || !plain.Serialize(plainOut) || plain.records.size() != 12 || plain.records[8].tags.size() != 0 || plain.records[4].name != "m4") {
+            throw 1;
+        }
+        for(int pass = 0; pass < 2; pass ++) {
+            auto learnedCtx = learned.Deserialize(inp, JSONReflection::ParseFlags::LEARN_KEY_ORDER);
+            learnedOut.clear();
+            if(!learnedCtx || !learned.Serialize(learnedOut) || learnedOut != plainOut) {
+                throw 1;
+            }
+            auto p = plainCtx.keyMatchStats(), l = learnedCtx.keyMatchStats();
+            if(l.predicted + l.lookedUp != p.predicted + p.lookedUp || l.unknown != p.unknown || l.predicted <= p.predicted) {
+                throw 1;
+            }
+        }
+    }
+    {
+        // a zero and DeserializePadding readable bytes after the data
+        std::string inp = R"({"lat": 43.420273, "lon":-65.613617,"alt":1230})";
+        std::string padded = inp;
+        padded.resize(inp.size() + JSONReflection::DeserializePadding);
+        TestFeatures::Position p1, p2;
+        if(!p1.Deserialize(inp) || !p2.DeserializePadded(padded.data(), inp.size()) || p1.alt != p2.alt || p2.lon != -65.613617) {
+            throw 1;
+        }
+        // the end is still found inside a number or a string
+        for(std::size_t size: {inp.size() - 1, inp.size() - 3, std::size_t(10)}) {
+            padded = inp.substr(0, size);
+            padded.resize(size + JSONReflection::DeserializePadding);
+            auto ctx = p2.DeserializePadded(padded.data(), size);
+            if(ctx || ctx.getErrorOffset() != p1.Deserialize(inp.substr(0, size)).getErrorOffset()) {
+                throw 1;
+            }
+        }
+        // padding with no zero first doesn't stop digit runs
+        padded = inp;
+        padded.resize(inp.size() + JSONReflection::DeserializePadding, '1');
+        auto ctx = p2.DeserializePadded(padded.data(), inp.size());
+        if(ctx || ctx.getErrorOffset() != inp.size()) {
+            throw 1;
+        }
+    }
+    {
+        // unicode escapes are written as UTF-8, surrogate pairs as one code point
+        J<TestFeatures::InnerStruct> s;
+        std::string inp = R"({"name": "\u0041\u00e9\u20AC\uD83D\uDE00 \u00E9x", "value": 1})";
+        if(!s.Deserialize(inp) || string(s.name) != "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 \xC3\xA9x") {
+            throw 1;
+        }
+        std::string run = R"({"name": ")", expected;
+        for(int i = 0; i < 40; i ++) {
+            run += R"(\u20ac)";
+            expected += "\xE2\x82\xAC";
+        }
+        if(!s.Deserialize(run + R"("})") || string(s.name) != expected) {
+            throw 1;
+        }
+        // unpaired surrogates are U+FFFD, STRICT rejects them
+        std::string replacement = "\xEF\xBF\xBD";
+        for(auto [lone, text]: std::initializer_list<std::pair<std::string, std::string>>{
+                {R"({"name": "\uD83D"})", replacement}, {R"({"name": "\uDE00\uD83D"})", replacement + replacement},
+                {R"({"name": "\uD83D\u0041"})", replacement + "A"}, {R"({"name": "\uD83Dx"})", replacement + "x"}}) {
+            if(!s.Deserialize(lone) || string(s.name) != text || s.Deserialize(lone, JSONReflection::ParseFlags::STRICT)) {
+                throw 1;
+            }
+        }
+    }
+    {
+        TestFeatures::RootObject t;
+        auto strict = JSONReflection::ParseFlags::STRICT;
+        std::string valid = "{\"a\": 1, \"string_like\": \"h\xC3\xA9llo \xF0\x9F\x98\x80\", \"skip\": [1, {\"x\": \"\xE2\x82\xAC\"}], \"primitive_array\": [true, false], \"flag_map\": {\"x\": true, \"y\": false}} ";
+        if(!t.Deserialize(valid, strict) || t.primitive_array.size() != 2 || t.flag_map.size() != 2) {
+            throw 1;
+        }
+        // all of these are accepted without STRICT
+        for(std::string inp: {
+                "{\"a\": 1 \"primitive_array\": [true]}",
+                "{\"primitive_array\": [true false]}",
+                "{\"primitive_array\": [true, false,]}",
+                "{\"ints_array\": [1, 2, 3, 4, 5,]}",
+                "{\"flag_map\": {\"x\": true \"y\": false}}",
+                "{\"a\": 1,}",
+                "{\"skip\": [[] {}]}",
+                "{\"string_like\": \"\xC3\"}",
+                "{\"skip\": \"\xED\xA0\x80\"}",
+                "{\"\xFF\": 1}",
+                "{\"string_like\": \"a\x01\"}",
+                "{\"a\": 1} x"}) {
+            std::string padded = inp;
+            padded.resize(inp.size() + JSONReflection::DeserializePadding);
+            if(!t.Deserialize(inp) || t.Deserialize(inp, strict) || t.DeserializePadded(padded.data(), inp.size(), strict) || t.DeserializeIndexed(inp, strict)) {
+                throw 1;
+            }
+        }
+        // truncated documents are rejected in every mode
+        for(std::string inp: {
+                "{\"a\": 1, \"skip\": \"",
+                "{\"a\": 1, \"skip\": \"abc\"",
+                "{\"a\": 1, \"skip\": [\"",
+                "{\"a\": 1, \"skip\": {\"b\": \"",
+                "{\"a\": 1, \"skip\": [1, ",
+                "{\"a\": 1, \"skip\": tru",
+                "{\"a\": 1, \"string_like\": \"ab",
+                "{\"a\": 1"}) {
+            std::string padded = inp;
+            padded.resize(inp.size() + JSONReflection::DeserializePadding);
+            for(auto flags: {JSONReflection::ParseFlags::DEFAULT, strict}) {
+                if(t.Deserialize(inp, flags) || t.DeserializePadded(padded.data(), inp.size(), flags) || t.DeserializeIndexed(inp, flags)) {
+                    throw 1;
+                }
+            }
+        }
+    }
+    {
+        // every kernel level this CPU runs gives the same result
+        using JSONReflection::SimdLevel;
+        std::string inp = "{\"a\": 7,   \"string_like\": \"" + std::string(70, 'x') + "\\\"\\\\ \xE2\x82\xAC" + std::string(40, 'y') + "\\n\", "
+                          "\"skip\": [\"" + std::string(100, ' ') + "\\\\\\\"\", {}], \"primitive_array\": [true]}" + std::string(130, ' ');
+        SimdLevel initial = JSONReflection::simdLevel();
+        SimdLevel best = SimdLevel::SCALAR;
+        std::string reference;
+        for(SimdLevel level: {SimdLevel::SSE2, SimdLevel::SSE4_2, SimdLevel::AVX2, SimdLevel::AVX512, initial}) {
+            if(!JSONReflection::setSimdLevel(level)) {
+                continue;
+            }
+            // the kernels report the level they are compiled for, not the requested one
+            if(JSONReflection::simdLevel() != level) {
+                throw 1;
+            }
+            best = std::max(best, level);
+            TestFeatures::RootObject t, indexed;
+            std::string out, indexedOut;
+            if(!t.Deserialize(inp, JSONReflection::ParseFlags::STRICT) || !t.Serialize(out)) {
+                throw 1;
+            }
+            if(!indexed.DeserializeIndexed(inp, JSONReflection::ParseFlags::STRICT) || !indexed.Serialize(indexedOut) || indexedOut != out) {
+                throw 1;
+            }
+            if(reference.empty()) {
+                reference = out;
+            } else if(out != reference) {
+                throw 1;
+            }
+        }
+        // the first parse picks the best kernels the CPU runs
+        if(JSONReflection::simdLevel() != initial || initial != best) {
+            throw 1;
+        }
+    }
+    {
+        // the same values through the structural index, one index reused
+        JSONReflection::StructuralIndex index;
+        std::string inp = "{\"skip\": {\"x\": [1, \"]}\\\"\", {\"y\": [[], {}]}], \"z\": null},\n    \"string_like\": \"a\\\"b\\\\\", "
+                          "\"a\": 12,\t\"primitive_array\": [true,  false], \"flag_map\": {\"k\\u00e9y\": true}" + std::string(100, ' ') + "}";
+        for(auto flags: {JSONReflection::ParseFlags::DEFAULT, JSONReflection::ParseFlags::STRICT, JSONReflection::ParseFlags::TRUSTED_INPUT}) {
+            TestFeatures::RootObject t, indexed;
+            std::string out, indexedOut;
+            if(!t.Deserialize(inp, flags) || !t.Serialize(out) || !indexed.DeserializeIndexed(inp, index, flags) || !indexed.Serialize(indexedOut) || out != indexedOut) {
+                throw 1;
+            }
+        }
+        // a multi-threaded index is the same, chunk borders fall inside the long string and the array
+        std::string large = "{\"string_like\": \", ";
+        while(large.size() < 3 * JSONReflection::d::MinIndexChunkSize) {
+            large += "\\\"x\\\\, ";
+        }
+        large += "\", \"skip\": [";
+        while(large.size() < 6 * JSONReflection::d::MinIndexChunkSize) {
+            large += "{\"k\": [\"]\", true]}, ";
+        }
+        large += "1], \"a\": 5}";
+        JSONReflection::StructuralIndex threadedIndex(4);
+        TestFeatures::RootObject fromThreaded, fromSingle;
+        std::string threadedOut, singleOut;
+        if(!fromThreaded.DeserializeIndexed(large, threadedIndex) || !fromSingle.DeserializeIndexed(large, index)
+                || threadedIndex.size() != index.size() || !std::equal(index.begin(), index.end(), threadedIndex.begin())
+                || fromThreaded.a != 5 || !fromThreaded.Serialize(threadedOut) || !fromSingle.Serialize(singleOut) || threadedOut != singleOut) {
+            throw 1;
+        }
+        TestFeatures::RootObject t;
+        for(std::string broken: {"{\"skip\": [1, {\"x\": 2]}", "{\"skip\": [[1]", "{\"a\": 1, \"string_like\": \"abc", "{\"skip\": \"\\x\"}"}) {
+            if(t.DeserializeIndexed(broken, index)) {
+                throw 1;
+            }
+        }
+        // a skipped value is accepted through the index exactly when it is accepted without it
+        for(std::string skip: {"[[] {}]", "[1, true,]", "{\"x\": true \"y\": [null],}", "[\"a\\\"b\" {\"k\\u00e9\": -1.5e3}]", "{}"}) {
+            std::string inp = "{\"skip\": " + skip + ", \"a\": 3}";
+            if(!t.Deserialize(inp) || !t.DeserializeIndexed(inp, index) || t.a != 3) {
+                throw 1;
+            }
+        }
+        for(std::string skip: {
+                "[{]]", "{\"x\": [}}", "[1: 2]", "{\"x\" 1}", "{\"x\":: 1}", "{\"x\": }", "[1,, 2]", "[, 1]",
+                "{, \"x\": 1}", "{1: 2}", "{\"x\": 1, \"y\"}", "[tru]", "[1x]", "[\"a\" x]", "[\"\\q\"]", "[-]", "[[1] 2:]"}) {
+            std::string inp = "{\"skip\": " + skip + ", \"a\": 3}";
+            if(t.Deserialize(inp) || t.DeserializeIndexed(inp, index)) {
+                throw 1;
+            }
+        }
+    }
+    {
+        TestFeatures::Telemetry t;
+        t.id = array<char, 15>{{'\n', '\x01', 'g', 'w'}};
+        t.seq = std::numeric_limits<int32_t>::min();
+        t.track[1].lat = -1000000000000000.125;
+        std::array<char, TestFeatures::Telemetry::MaxSerializedSize() + JSONReflection::UncheckedSlack> buf;
+        std::size_t size;
+        std::string out;
+        if(!t.Serialize(buf, size) || !t.Serialize(out) || std::string(buf.data(), size) != out || size > t.MaxSerializedSize()) {
+            throw 1;
+        }
+        checkExactSize(t);
+    }
+    {
+        // sizes of escapes, digit count borders, integer limits and every double layout
+        TestFeatures::SizeEdges s;
+        s.text = "q\"b\\s\b\f\r\n\t\x01\x1f\x7f \xC3\xA9" + string(70, 'x') + "\"end\\";
+        for(int64_t v: {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), int64_t(-1), int64_t(0),
+                        int64_t(9), int64_t(10), int64_t(99), int64_t(100), int64_t(999999999999999999), int64_t(-1000000000000000000)}) {
+            s.ints.push_back(v);
+        }
+        s.u64 = std::numeric_limits<uint64_t>::max();
+        s.i32 = std::numeric_limits<int32_t>::min();
+        for(double v: {0.0, -0.0, 5e-324, 1.7976931348623157e308, -2.2250738585072014e-308, 0.1, 1e-7, 1e-6, 1e20, 1e21, 1e22,
+                       123456789012345680.0, -9.999999999999999e22, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()}) {
+            s.doubles.push_back(v);
+        }
+        for(auto [lat, alt]: std::initializer_list<std::pair<double, double>>{{0.0, 1234.5}, {-0.0, 0.000999999}, {43.420273000000009, 99950},
+                {-1000000000000000.125, 1e-300}, {1e300, 9.995}, {0.00000005, -1e300}, {999.99999995, 0.0}, {-1e-9, -0.0}}) {
+            TestFeatures::Position p;
+            p.lat = lat;
+            p.lon = -lat;
+            p.alt = alt;
+            s.track.push_back(p);
+        }
+        checkExactSize(s);
+    }
 //    return twitterJsonPerfTest();
 //    return canadaJsonPerfTest();
+//    return hardNumbersPerfTest();
     constexpr char inp3const[]{R"(
         {
             "skip_me2" :  "..  .",
@@ -137,6 +460,21 @@ int main()
     if (inp3 != inp3copy) {
         throw 1;
     }
+    checkExactSize(t3);
+    {
+        // the trusted parser gives the same result on valid input
+        TestFeatures::RootObject t4;
+        string out3, out4;
+        if(!t4.Deserialize(inp3, JSONReflection::ParseFlags::TRUSTED_INPUT) || !t3.Serialize(out3) || !t4.Serialize(out4) || out3 != out4) {
+            throw 1;
+        }
+        out4.clear();
+        inp3copy.resize(inp3.size() + JSONReflection::DeserializePadding);
+        if(!t4.DeserializePadded(inp3copy.data(), inp3.size(), JSONReflection::ParseFlags::TRUSTED_INPUT) || !t4.Serialize(out4) || out3 != out4) {
+            throw 1;
+        }
+        inp3copy = inp3;
+    }
     doPerformanceTest("Perf Test For t3.Deserialize", 2000000, [&t3, &b, &e]{
         bool res1 = t3.Deserialize(b, e);
         if(!res1) throw 1;
@@ -162,6 +500,7 @@ int main()
             .primitive_array {{true, false, true, false}},
             .ints_array {{10, 100, 1000, 10000, 100000}}
                         }};
+    checkExactSize(testInit);
 
     std::size_t counter = 0;
 
@@ -0,0 +1,931 @@
+#ifndef NUMBER_OPS_HPP
+#define NUMBER_OPS_HPP
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <fast_double_parser.h>
+#include <simdjson/to_chars.hpp>
+#include "number_tables.hpp"
+
+namespace JSONReflection {
+namespace d {
+
+inline bool isDigit(char c) {
+    return std::uint8_t(c - '0') < 10;
+}
+
+// SWAR digit parsing, 8 ASCII digits packed into little-endian std::uint64_t
+inline bool isMadeOfEightDigits(std::uint64_t val) {
+    return (((val & 0xF0F0F0F0F0F0F0F0) | (((val + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333);
+}
+
+inline std::uint32_t parseEightDigits(std::uint64_t val) {
+    constexpr std::uint64_t mask = 0x000000FF000000FF;
+    constexpr std::uint64_t mul1 = 0x000F424000000064; // 100 + (1000000ULL << 32)
+    constexpr std::uint64_t mul2 = 0x0000271000000001; // 1 + (10000ULL << 32)
+    val -= 0x3030303030303030;
+    val = (val * 10) + (val >> 8);
+    return std::uint32_t((((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32);
+}
+
+enum class IntegerParseResult {
+    OK,
+    NOT_INTEGER,
+    ILLFORMED,
+    OUT_OF_RANGE
+};
+
+/*
+ * Number parsers below take ZeroTerminated = true for input followed by a zero byte and
+ * DeserializePadding readable bytes: the zero stops every digits run, so the runs are
+ * scanned with no end checks, and eight digits may be read at once up to the end
+ */
+template<bool ZeroTerminated>
+inline bool notEnd(const char * p, const char * end) {
+    return ZeroTerminated || p != end;
+}
+
+/*
+ * Parses JSON integer at [begin, end) into any integral type, without going through double.
+ * On OK begin points to the first char after the number.
+ * NOT_INTEGER means the number has fraction or exponent part, begin is not moved then.
+ */
+template<bool ZeroTerminated = false, class IntT> requires std::is_integral_v<IntT>
+IntegerParseResult parseInteger(const char * & begin, const char * end, IntT & value) {
+    const char * p = begin;
+    bool negative = false;
+    if(notEnd<ZeroTerminated>(p, end) && *p == '-') {
+        negative = true;
+        p ++;
+    }
+    const char * digitsBegin = p;
+    std::uint64_t magnitude = 0;
+    // two SWAR steps cover 16 digits, which can't overflow std::uint64_t
+    for(int i = 0; i < 2 && (ZeroTerminated || end - p >= 8); i ++) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, p, sizeof(chunk));
+        if(!isMadeOfEightDigits(chunk)) {
+            break;
+        }
+        magnitude = magnitude * 100000000 + parseEightDigits(chunk);
+        p += 8;
+    }
+    while(notEnd<ZeroTerminated>(p, end) && isDigit(*p)) {
+        magnitude = magnitude * 10 + std::uint64_t(*p - '0');
+        p ++;
+    }
+    std::size_t digitsCount = p - digitsBegin;
+    if(digitsCount == 0 || (*digitsBegin == '0' && digitsCount > 1)) [[unlikely]] {
+        return IntegerParseResult::ILLFORMED;
+    }
+    if(notEnd<ZeroTerminated>(p, end) && (*p == '.' || *p == 'e' || *p == 'E')) [[unlikely]] {
+        return IntegerParseResult::NOT_INTEGER;
+    }
+    if(digitsCount > 19) [[unlikely]] {
+        // 19 digits always fit, 20 digits may still fit std::uint64_t
+        if(digitsCount > 20) {
+            return IntegerParseResult::OUT_OF_RANGE;
+        }
+        magnitude = 0;
+        for(const char * d = digitsBegin; d != p; d ++) {
+            if(__builtin_mul_overflow(magnitude, 10, &magnitude)
+                    || __builtin_add_overflow(magnitude, std::uint64_t(*d - '0'), &magnitude)) {
+                return IntegerParseResult::OUT_OF_RANGE;
+            }
+        }
+    }
+    if constexpr (std::is_signed_v<IntT>) {
+        using UnsignedT = std::make_unsigned_t<IntT>;
+        constexpr std::uint64_t maxPositive = std::uint64_t(std::numeric_limits<IntT>::max());
+        if(magnitude > maxPositive + (negative ? 1 : 0)) [[unlikely]] {
+            return IntegerParseResult::OUT_OF_RANGE;
+        }
+        // two's complement negation of the magnitude covers the minimal value too
+        value = negative ? IntT(UnsignedT(0) - UnsignedT(magnitude)) : IntT(magnitude);
+    } else {
+        if((negative && magnitude != 0) || magnitude > std::uint64_t(std::numeric_limits<IntT>::max())) [[unlikely]] {
+            return IntegerParseResult::OUT_OF_RANGE;
+        }
+        value = IntT(magnitude);
+    }
+    begin = p;
+    return IntegerParseResult::OK;
+}
+
+// Unsigned integer of a fixed capacity, just enough for exact comparisons of
+// decimal numbers with halfway points between doubles
+struct BigUnsigned {
+    // 768 digits or 5^1092 times a 54-bit mantissa take about 2600 bits
+    static constexpr int MaxLimbs = 64;
+    std::uint64_t limbs[MaxLimbs]; // little-endian
+    int size = 0;
+
+    BigUnsigned(const BigUnsigned & other) : size(other.size) {
+        std::memcpy(limbs, other.limbs, size * sizeof(limbs[0]));
+    }
+    BigUnsigned & operator=(const BigUnsigned & other) {
+        size = other.size;
+        std::memcpy(limbs, other.limbs, size * sizeof(limbs[0]));
+        return *this;
+    }
+
+    explicit BigUnsigned(std::uint64_t v = 0) {
+        limbs[0] = v;
+        size = v != 0;
+    }
+
+    void mulAdd(std::uint64_t mul, std::uint64_t add) {
+        std::uint64_t carry = add;
+        for(int i = 0; i < size; i ++) {
+            unsigned __int128 v = static_cast<unsigned __int128>(limbs[i]) * mul + carry;
+            limbs[i] = std::uint64_t(v);
+            carry = std::uint64_t(v >> 64);
+        }
+        if(carry != 0) {
+            limbs[size ++] = carry;
+        }
+    }
+
+    static constexpr std::uint64_t Pow5_27 = 7450580596923828125ULL;
+
+    void mulPow5(std::uint32_t n) {
+        for(; n >= 27; n -= 27) {
+            mulAdd(Pow5_27, 0);
+        }
+        std::uint64_t rest = 1;
+        for(; n > 0; n --) {
+            rest *= 5;
+        }
+        mulAdd(rest, 0);
+    }
+
+    // 5^n for n up to 1106, most of it taken from a compile-time table
+    static BigUnsigned pow5(std::uint32_t n);
+
+    void shiftLeft(std::uint32_t n) {
+        if(size == 0) {
+            return;
+        }
+        int limbsShift = int(n / 64);
+        int bitsShift = int(n % 64);
+        if(bitsShift != 0) {
+            std::uint64_t carry = 0;
+            for(int i = 0; i < size; i ++) {
+                std::uint64_t v = limbs[i];
+                limbs[i] = v << bitsShift | carry;
+                carry = v >> (64 - bitsShift);
+            }
+            if(carry != 0) {
+                limbs[size ++] = carry;
+            }
+        }
+        if(limbsShift != 0) {
+            for(int i = size - 1; i >= 0; i --) {
+                limbs[i + limbsShift] = limbs[i];
+            }
+            for(int i = 0; i < limbsShift; i ++) {
+                limbs[i] = 0;
+            }
+            size += limbsShift;
+        }
+    }
+
+    int compare(const BigUnsigned & other) const {
+        if(size != other.size) {
+            return size < other.size ? -1 : 1;
+        }
+        for(int i = size - 1; i >= 0; i --) {
+            if(limbs[i] != other.limbs[i]) {
+                return limbs[i] < other.limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+};
+
+// 5^(27 * j), the chain of multiplications by 5^27 unrolled at compile time
+struct PowersOfFive27 {
+    static constexpr int Count = 41;
+    std::uint16_t offsets[Count + 1] {};
+    std::uint64_t limbs[821] {}; // total size of the powers
+
+    constexpr PowersOfFive27() {
+        std::uint64_t power[BigUnsigned::MaxLimbs] {1};
+        int size = 1;
+        int total = 0;
+        for(int j = 0; j < Count; j ++) {
+            offsets[j] = std::uint16_t(total);
+            for(int i = 0; i < size; i ++) {
+                limbs[total ++] = power[i];
+            }
+            std::uint64_t carry = 0;
+            for(int i = 0; i < size; i ++) {
+                unsigned __int128 v = static_cast<unsigned __int128>(power[i]) * BigUnsigned::Pow5_27 + carry;
+                power[i] = std::uint64_t(v);
+                carry = std::uint64_t(v >> 64);
+            }
+            if(carry != 0) {
+                power[size ++] = carry;
+            }
+        }
+        offsets[Count] = std::uint16_t(total);
+    }
+};
+inline constexpr PowersOfFive27 PowersOfFive{};
+
+inline BigUnsigned BigUnsigned::pow5(std::uint32_t n) {
+    BigUnsigned ret;
+    std::uint32_t j = n / 27;
+    ret.size = PowersOfFive.offsets[j + 1] - PowersOfFive.offsets[j];
+    std::memcpy(ret.limbs, PowersOfFive.limbs + PowersOfFive.offsets[j], ret.size * sizeof(ret.limbs[0]));
+    ret.mulPow5(n % 27);
+    return ret;
+}
+
+/*
+ * Double within a few ulps of w * 10^k, for w != 0 and k in the Pow10Table range: the product
+ * with the truncated 128-bit power of ten, with no rounding checks. Clamped to the largest double
+ */
+inline double approximateDecimal(std::uint64_t w, int k) {
+    const int wShift = __builtin_clzll(w);
+    const UInt128Parts g = Pow10Table[k - Pow10TableMinExponent];
+    std::uint64_t p = std::uint64_t((static_cast<unsigned __int128>(w << wShift) * g.hi) >> 64);
+    const int pShift = __builtin_clzll(p);
+    p <<= pShift;
+    // w * 10^k ~ p * 2^(floor(log2(10^k)) + 1 - wShift - pShift), p in [2^63, 2^64)
+    const std::int64_t biasedExponent = ((k * 1741647) >> 19) + 1 - wShift - pShift + 1086;
+    if(biasedExponent >= 2047) {
+        return std::numeric_limits<double>::max();
+    }
+    std::uint64_t bits = 1;
+    if(biasedExponent > 0) {
+        bits = std::uint64_t(biasedExponent) << 52 | ((p >> 11) & ((std::uint64_t(1) << 52) - 1));
+    }
+    double ret;
+    std::memcpy(&ret, &bits, sizeof(ret));
+    return ret;
+}
+
+/*
+ * Correctly rounded conversion for the numbers Eisel-Lemire can't decide: more than 19
+ * significant digits close to a halfway point, or exponents beyond its power tables.
+ * The value is the integer and fraction digits, taken as one integer, times 10^exponent.
+ * At most 768 significant digits are kept: halfway points between doubles never have more,
+ * so dropped nonzero digits only break exact ties.
+ * A candidate double within a few ulps is refined by comparing the exact value with
+ * the halfway points to its neighbours (digit comparison, as in fast_float).
+ * Returns false on overflow to infinity
+ */
+inline bool parseDoubleExact(bool negative, const char * intBegin, const char * intEnd,
+                             const char * fracBegin, const char * fracEnd, std::int64_t exponent, double & value) {
+    constexpr std::int32_t MaxDigits = 768;
+    constexpr std::uint64_t pow10_19 = 10000000000000000000ULL;
+    constexpr std::uint64_t powersOf10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+        10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+        1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL
+    };
+    BigUnsigned digits;
+    std::uint64_t chunk = 0;
+    int chunkDigits = 0;
+    std::uint64_t leadingDigits = 0;
+    std::int32_t taken = 0;
+    std::int64_t q = exponent;
+    bool truncated = false;
+    auto takeDigits = [&](const char * p, const char * end) {
+        if(taken == 0) {
+            // leading zeros are not significant
+            while(p != end && *p == '0') {
+                p ++;
+            }
+        }
+        const char * takeEnd = p + std::min<std::int64_t>(end - p, MaxDigits - taken);
+        taken += std::int32_t(takeEnd - p);
+        while(p != takeEnd) {
+            if(chunkDigits <= 11 && takeEnd - p >= 8) {
+                std::uint64_t eight;
+                std::memcpy(&eight, p, sizeof(eight));
+                chunk = chunk * 100000000 + parseEightDigits(eight);
+                chunkDigits += 8;
+                p += 8;
+            } else {
+                chunk = chunk * 10 + std::uint64_t(*p - '0');
+                chunkDigits ++;
+                p ++;
+            }
+            if(chunkDigits == 19) {
+                if(digits.size == 0) {
+                    leadingDigits = chunk;
+                }
+                digits.mulAdd(pow10_19, chunk);
+                chunk = 0;
+                chunkDigits = 0;
+            }
+        }
+        // dropped digits scale the kept ones
+        q += end - takeEnd;
+        for(; p != end; p ++) {
+            truncated = truncated || *p != '0';
+        }
+    };
+    takeDigits(intBegin, intEnd);
+    takeDigits(fracBegin, fracEnd);
+    if(taken < 19) {
+        leadingDigits = chunk;
+    }
+    digits.mulAdd(powersOf10[chunkDigits], chunk);
+
+    std::uint64_t bits = 0;
+    if(taken == 0 || taken + q <= -324) {
+        // below 10^-324, less than half of the smallest subnormal
+        bits = 0;
+    } else if(taken + q > 309) {
+        return false;
+    } else {
+        // candidate from the leading digits, a few ulps off at most: Eisel-Lemire,
+        // scaled into the normal range for subnormals, or the truncated product on its failures.
+        // e + scale stays in [-292, 308], inside the power tables of both
+        std::int64_t e = q + taken - std::min(taken, 19);
+        std::int64_t scale = e < -270 ? 50 : 0;
+        bool success = false;
+        double candidate = fast_double_parser::compute_float_64(e + scale, leadingDigits, false, &success);
+        if(!success) {
+            candidate = approximateDecimal(leadingDigits, int(e + scale));
+        }
+        if(scale != 0) {
+            candidate *= 1e-50;
+        }
+        candidate = std::min(candidate, std::numeric_limits<double>::max());
+        std::memcpy(&bits, &candidate, sizeof(bits));
+
+        // value vs halfway point above a double: digits * 5^q * 2^q vs (2m + 1) * 2^(e - 1)
+        BigUnsigned scaledDigits = digits;
+        BigUnsigned pow5(1);
+        if(q >= 0) {
+            scaledDigits.mulPow5(std::uint32_t(q));
+        } else {
+            pow5 = BigUnsigned::pow5(std::uint32_t(-q));
+        }
+        auto compareWithHalfway = [&scaledDigits, &pow5, q, truncated](std::uint64_t bits) {
+            std::uint64_t m = bits & ((std::uint64_t(1) << 52) - 1);
+            std::int64_t e = -1074;
+            if(bits >> 52 != 0) {
+                m |= std::uint64_t(1) << 52;
+                e = std::int64_t(bits >> 52) - 1075;
+            }
+            BigUnsigned left = scaledDigits;
+            BigUnsigned right = pow5;
+            right.mulAdd(2 * m + 1, 0);
+            std::int64_t shift = (e - 1) - q;
+            if(shift > 0) {
+                right.shiftLeft(std::uint32_t(shift));
+            } else {
+                left.shiftLeft(std::uint32_t(-shift));
+            }
+            int c = left.compare(right);
+            return c == 0 && truncated ? 1 : c;
+        };
+        constexpr std::uint64_t infinityBits = std::uint64_t(0x7FF) << 52;
+        int c;
+        while((c = compareWithHalfway(bits)) > 0) {
+            bits ++;
+            if(bits == infinityBits) {
+                return false;
+            }
+        }
+        if(c == 0) {
+            // ties to even
+            bits += bits & 1;
+            if(bits == infinityBits) {
+                return false;
+            }
+        } else {
+            while(bits != 0) {
+                c = compareWithHalfway(bits - 1);
+                if(c > 0) {
+                    break;
+                }
+                bits --;
+                if(c == 0) {
+                    bits += bits & 1;
+                    break;
+                }
+            }
+        }
+    }
+    bits |= std::uint64_t(negative) << 63;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+/*
+ * Parses JSON number at [begin, end) directly from the input buffer.
+ * Returns the first char after the number, nullptr if there is no valid number or it overflows
+ * double, or end if the data ends right after the digits: a JSON number is always followed
+ * by a delimiter, which also guards the exact conversion reading the number again.
+ * The result is always correctly rounded, libc is never involved.
+ */
+template<bool ZeroTerminated = false>
+inline const char * parseDouble(const char * begin, const char * end, double & value) {
+    const char * p = begin;
+    bool negative = false;
+    if(notEnd<ZeroTerminated>(p, end) && *p == '-') {
+        negative = true;
+        p ++;
+    }
+    const char * intBegin = p;
+    std::uint64_t mantissa = 0;
+    while(notEnd<ZeroTerminated>(p, end) && isDigit(*p)) {
+        mantissa = mantissa * 10 + std::uint64_t(*p - '0');
+        p ++;
+    }
+    const char * intEnd = p;
+    if(intEnd == intBegin || (*intBegin == '0' && intEnd - intBegin > 1)) [[unlikely]] {
+        return nullptr;
+    }
+    std::int64_t exponent = 0;
+    const char * fracBegin = p;
+    if(notEnd<ZeroTerminated>(p, end) && *p == '.') {
+        p ++;
+        fracBegin = p;
+        // coordinates-like numbers have long fractions
+        while(ZeroTerminated || end - p >= 8) {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, p, sizeof(chunk));
+            if(!isMadeOfEightDigits(chunk)) {
+                break;
+            }
+            mantissa = mantissa * 100000000 + parseEightDigits(chunk);
+            p += 8;
+        }
+        while(notEnd<ZeroTerminated>(p, end) && isDigit(*p)) {
+            mantissa = mantissa * 10 + std::uint64_t(*p - '0');
+            p ++;
+        }
+        if(p == fracBegin) [[unlikely]] {
+            return nullptr;
+        }
+        exponent = fracBegin - p;
+    }
+    const char * fracEnd = p;
+    std::int64_t digitsCount = (intEnd - intBegin) + (fracEnd - fracBegin);
+    if(notEnd<ZeroTerminated>(p, end) && (*p == 'e' || *p == 'E')) {
+        p ++;
+        bool negativeExponent = false;
+        if(notEnd<ZeroTerminated>(p, end) && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            p ++;
+        }
+        const char * expBegin = p;
+        std::int64_t expNumber = 0;
+        while(notEnd<ZeroTerminated>(p, end) && isDigit(*p)) {
+            if(expNumber < 0x100000000) {
+                expNumber = 10 * expNumber + (*p - '0');
+            }
+            p ++;
+        }
+        if(p == expBegin) [[unlikely]] {
+            return nullptr;
+        }
+        exponent += negativeExponent ? -expNumber : expNumber;
+    }
+    if(p == end) [[unlikely]] {
+        return end;
+    }
+
+    bool success = false;
+    if(digitsCount <= 19) [[likely]] {
+        if(exponent >= FASTFLOAT_SMALLEST_POWER && exponent <= FASTFLOAT_LARGEST_POWER) [[likely]] {
+            value = fast_double_parser::compute_float_64(exponent, mantissa, negative, &success);
+        }
+    } else {
+        // leading zeros, like in 0.000123, are not significant
+        const char * c = intBegin;
+        while(c != fracEnd && (*c == '0' || *c == '.')) {
+            c ++;
+        }
+        // the first 19 significant digits truncate the value; if rounding it up by one unit
+        // gives the same double, the remaining digits don't matter
+        std::uint64_t truncated = 0;
+        std::int64_t taken = 0;
+        std::int64_t significant = 0;
+        for(; c != fracEnd; c ++) {
+            if(*c == '.') {
+                continue;
+            }
+            if(taken < 19) {
+                truncated = truncated * 10 + std::uint64_t(*c - '0');
+                taken ++;
+            }
+            significant ++;
+        }
+        std::int64_t truncatedExponent = exponent + significant - taken;
+        if(truncatedExponent >= FASTFLOAT_SMALLEST_POWER && truncatedExponent <= FASTFLOAT_LARGEST_POWER) {
+            value = fast_double_parser::compute_float_64(truncatedExponent, truncated, negative, &success);
+            if(success && significant > taken) {
+                bool upperSuccess = false;
+                double upper = fast_double_parser::compute_float_64(truncatedExponent, truncated + 1, negative, &upperSuccess);
+                success = upperSuccess && upper == value;
+            }
+        }
+    }
+    if(!success) [[unlikely]] {
+        if(!parseDoubleExact(negative, intBegin, intEnd, fracBegin, fracEnd, exponent, value)) {
+            return nullptr;
+        }
+    }
+    return p;
+}
+
+// True if truncating x towards zero gives a value representable in IntT
+template<class IntT> requires std::is_integral_v<IntT>
+bool doubleFitsInteger(double x) {
+    constexpr double upper = double(std::numeric_limits<IntT>::max() / 2 + 1) * 2.0;
+    if constexpr (std::is_signed_v<IntT>) {
+        return x >= double(std::numeric_limits<IntT>::min()) && x < upper;
+    } else {
+        return x > -1.0 && x < upper;
+    }
+}
+
+inline constexpr char DigitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+inline unsigned decimalDigitsCount(std::uint64_t v) {
+    constexpr std::uint64_t powersOf10[] = {
+        0, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+        10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+        1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+        10000000000000000000ULL
+    };
+    // log10 estimation from the bit width, 1233/4096 ~ log10(2)
+    unsigned t = (64 - __builtin_clzll(v | 1)) * 1233 >> 12;
+    return t + (v >= powersOf10[t]);
+}
+
+// Exactly 8 digits, zero padded; the four digit pairs don't depend on each other
+inline void writeEightDigits(char * out, std::uint32_t v) {
+    std::uint32_t hi = v / 10000;
+    std::uint32_t lo = v % 10000;
+    std::memcpy(out, DigitPairs + (hi / 100) * 2, 2);
+    std::memcpy(out + 2, DigitPairs + (hi % 100) * 2, 2);
+    std::memcpy(out + 4, DigitPairs + (lo / 100) * 2, 2);
+    std::memcpy(out + 6, DigitPairs + (lo % 100) * 2, 2);
+}
+
+// Writes decimal representation of v, two digits per step; returns the end of written chars
+inline char * writeUnsigned(char * out, std::uint64_t v) {
+    char * end = out + decimalDigitsCount(v);
+    char * p = end;
+    while(v >= 100000000) {
+        p -= 8;
+        writeEightDigits(p, std::uint32_t(v % 100000000));
+        v /= 100000000;
+    }
+    while(v >= 100) {
+        p -= 2;
+        std::memcpy(p, DigitPairs + (v % 100) * 2, 2);
+        v /= 100;
+    }
+    if(v >= 10) {
+        p -= 2;
+        std::memcpy(p, DigitPairs + v * 2, 2);
+    } else {
+        *--p = char('0' + v);
+    }
+    return end;
+}
+
+// Number of chars writeInteger writes
+template<class IntT> requires std::is_integral_v<IntT>
+std::size_t integerSize(IntT value) {
+    if constexpr (std::is_signed_v<IntT>) {
+        std::uint64_t magnitude = std::uint64_t(value);
+        if(value < 0) {
+            return 1 + decimalDigitsCount(0 - magnitude);
+        }
+        return decimalDigitsCount(magnitude);
+    } else {
+        return decimalDigitsCount(value);
+    }
+}
+
+// At most 20 chars are written for 64-bit types
+template<class IntT> requires std::is_integral_v<IntT>
+char * writeInteger(char * out, IntT value) {
+    if constexpr (std::is_signed_v<IntT>) {
+        std::uint64_t magnitude = std::uint64_t(value);
+        if(value < 0) {
+            *out++ = '-';
+            magnitude = 0 - magnitude;
+        }
+        return writeUnsigned(out, magnitude);
+    } else {
+        return writeUnsigned(out, value);
+    }
+}
+
+// Decimal representation digits * 10^exponent
+struct DecimalFloat {
+    std::uint64_t digits;
+    std::int32_t exponent;
+};
+
+// Upper 64 bits of g * cp, with the lowest bit set if the rest is not zero
+inline std::uint64_t roundToOdd(UInt128Parts g, std::uint64_t cp) {
+    unsigned __int128 x = static_cast<unsigned __int128>(g.lo) * cp;
+    unsigned __int128 y = static_cast<unsigned __int128>(g.hi) * cp + std::uint64_t(x >> 64);
+    return std::uint64_t(y >> 64) | (std::uint64_t(y) > 1);
+}
+
+/*
+ * Shortest decimal which reads back as the same finite positive double, the closest one
+ * if there are several (Giulietti's Schubfach, after Alexander Bolz's implementation).
+ * The result may have trailing zeros.
+ */
+inline DecimalFloat toShortestDecimal(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint64_t significand = bits & ((std::uint64_t(1) << 52) - 1);
+    const std::int32_t biasedExponent = std::int32_t(bits >> 52);
+    std::uint64_t c;
+    std::int32_t q;
+    if(biasedExponent != 0) {
+        c = significand | (std::uint64_t(1) << 52);
+        q = biasedExponent - 1075;
+        // integers below 2^53 are printed as they are
+        if(q <= 0 && -q < 53 && (c & ((std::uint64_t(1) << -q) - 1)) == 0) {
+            return {c >> -q, 0};
+        }
+    } else {
+        c = significand;
+        q = -1074;
+    }
+    const bool isEven = (c & 1) == 0;
+    const bool lowerBoundaryIsCloser = significand == 0 && biasedExponent > 1;
+    const std::uint64_t cbl = 4 * c - 2 + lowerBoundaryIsCloser;
+    const std::uint64_t cb = 4 * c;
+    const std::uint64_t cbr = 4 * c + 2;
+    // k = floor(log10(3/4 * 2^q)) or floor(log10(2^q))
+    const std::int32_t k = (q * 1262611 - (lowerBoundaryIsCloser ? 524031 : 0)) >> 22;
+    const std::int32_t h = q + ((-k * 1741647) >> 19) + 1;
+    const UInt128Parts pow10 = Pow10Table[-k - Pow10TableMinExponent];
+    const std::uint64_t vbl = roundToOdd(pow10, cbl << h);
+    const std::uint64_t vb = roundToOdd(pow10, cb << h);
+    const std::uint64_t vbr = roundToOdd(pow10, cbr << h);
+    const std::uint64_t lower = vbl + !isEven;
+    const std::uint64_t upper = vbr - !isEven;
+
+    // one digit less, if the interval contains such a number
+    const std::uint64_t s = vb / 4;
+    if(s >= 10) {
+        const std::uint64_t sp = s / 10;
+        const bool upInside = lower <= 40 * sp;
+        const bool wpInside = 40 * sp + 40 <= upper;
+        if(upInside != wpInside) {
+            return {sp + wpInside, k + 1};
+        }
+    }
+    const bool uInside = lower <= 4 * s;
+    const bool wInside = 4 * s + 4 <= upper;
+    if(uInside != wInside) {
+        return {s + wInside, k};
+    }
+    const std::uint64_t mid = 4 * s + 2;
+    const bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+    return {s + roundUp, k};
+}
+
+// Writes sign and zero the way the original Grisu2 based formatting did; returns nullptr if there is more to write
+inline char * writeDoubleSignAndZero(char * & out, double & value) {
+    if(std::signbit(value)) {
+        value = -value;
+        *out++ = '-';
+        if(value == 0) {
+            std::memcpy(out, "0.0", 3);
+            return out + 3;
+        }
+    } else if(value == 0) {
+        *out++ = '0';
+        return out;
+    }
+    return nullptr;
+}
+
+// Numbers in [1e-4, 1e15) are printed without exponent, like printf("%.17g")
+inline constexpr int DoubleFixedMinExponent = -4;
+inline constexpr int DoubleFixedMaxExponent = std::numeric_limits<double>::digits10;
+
+// Grisu2 (from 3party/simdjson/to_chars.cpp): round-trips, but is not always the shortest
+inline char * writeDoubleGrisu2(char * out, double value) {
+    if(char * end = writeDoubleSignAndZero(out, value)) {
+        return end;
+    }
+    int len = 0;
+    int decimalExponent = 0;
+    simdjson::internal::dtoa_impl::grisu2(out, len, decimalExponent, value);
+    return simdjson::internal::dtoa_impl::format_buffer(out, len, decimalExponent, DoubleFixedMinExponent, DoubleFixedMaxExponent);
+}
+
+/*
+ * Lays out digits * 10^exponent like format_buffer does, with no memmove of the whole buffer:
+ * the digits are written right where most of them belong. Up to 32 bytes of out may be overwritten
+ */
+inline char * writeDecimal(char * out, std::uint64_t digits, int exponent) {
+    const int len = int(decimalDigitsCount(digits));
+    const int point = len + exponent;
+    if(exponent >= 0 && point <= DoubleFixedMaxExponent) {
+        // digits[000]
+        writeUnsigned(out, digits);
+        std::memcpy(out + len, "0000000000000000", 16);
+        return out + point;
+    }
+    if(0 < point && point <= DoubleFixedMaxExponent) {
+        // dig.its, the integer part is short for most of the values
+        writeUnsigned(out + 1, digits);
+        for(int i = 0; i < point; i ++) {
+            out[i] = out[i + 1];
+        }
+        out[point] = '.';
+        return out + len + 1;
+    }
+    if(DoubleFixedMinExponent < point && point <= 0) {
+        // 0.[000]digits
+        std::memcpy(out, "0.000000", 8);
+        return writeUnsigned(out + 2 - point, digits);
+    }
+    // d.igitse+123
+    writeUnsigned(out + 1, digits);
+    out[0] = out[1];
+    if(len > 1) {
+        out[1] = '.';
+        out += len + 1;
+    } else {
+        out += 1;
+    }
+    *out++ = 'e';
+    return simdjson::internal::dtoa_impl::append_exponent(out, point - 1);
+}
+
+// writeDecimal without the trailing zeros of decimal.digits
+inline char * writeDecimalTrimmed(char * out, DecimalFloat decimal) {
+    if(decimal.exponent == 0 && decimal.digits < 1000000000000000ULL) {
+        // integral values, like 1000
+        return writeUnsigned(out, decimal.digits);
+    }
+    if(decimal.digits == 0) {
+        *out = '0';
+        return out + 1;
+    }
+    while(decimal.digits % 10 == 0) {
+        decimal.digits /= 10;
+        decimal.exponent ++;
+    }
+    return writeDecimal(out, decimal.digits, decimal.exponent);
+}
+
+// Number of chars writeDecimalTrimmed writes, without writing them
+inline std::size_t decimalTrimmedSize(DecimalFloat decimal) {
+    if(decimal.digits == 0) {
+        return 1;
+    }
+    while(decimal.digits % 10 == 0) {
+        decimal.digits /= 10;
+        decimal.exponent ++;
+    }
+    const int len = int(decimalDigitsCount(decimal.digits));
+    const int point = len + decimal.exponent;
+    if(decimal.exponent >= 0 && point <= DoubleFixedMaxExponent) {
+        return point;
+    }
+    if(0 < point && point <= DoubleFixedMaxExponent) {
+        return len + 1;
+    }
+    if(DoubleFixedMinExponent < point && point <= 0) {
+        return 2 - point + len;
+    }
+    const int e = point - 1 < 0 ? 1 - point : point - 1;
+    return (len > 1 ? len + 1 : 1) + 2 + (e < 100 ? 2 : 3);
+}
+
+// Shortest round-trip formatting, same layout as writeDoubleGrisu2. At most 24 chars are
+// written, but up to 32 bytes of out may be overwritten
+inline char * writeDoubleShortest(char * out, double value) {
+    if(char * end = writeDoubleSignAndZero(out, value)) {
+        return end;
+    }
+    return writeDecimalTrimmed(out, toShortestDecimal(value));
+}
+
+// Number of chars writeDoubleShortest writes, without writing them
+inline std::size_t doubleShortestSize(double value) {
+    std::size_t sign = 0;
+    if(std::signbit(value)) {
+        value = -value;
+        sign = 1;
+        if(value == 0) {
+            return 4;
+        }
+    } else if(value == 0) {
+        return 1;
+    }
+    return sign + decimalTrimmedSize(toShortestDecimal(value));
+}
+
+// Double formatting is picked at compile time: defining CPP_JSON_REFLECTION_GRISU2_DOUBLES
+// brings back Grisu2, which may print a few more digits
+inline char * writeDouble(char * out, double value) {
+#if defined(CPP_JSON_REFLECTION_GRISU2_DOUBLES)
+    return writeDoubleGrisu2(out, value);
+#else
+    return writeDoubleShortest(out, value);
+#endif
+}
+
+inline constexpr std::uint64_t PowersOfTen[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL
+};
+
+// Rounds decimal to a multiple of 10^minExponent, halves away from zero
+inline void roundDecimal(DecimalFloat & decimal, int minExponent) {
+    if(decimal.exponent >= minExponent) {
+        return;
+    }
+    const int dropped = minExponent - decimal.exponent;
+    decimal.exponent = minExponent;
+    if(dropped >= 20) {
+        // digits < 2^64 < 10^20 / 2
+        decimal.digits = 0;
+        return;
+    }
+    const std::uint64_t divisor = PowersOfTen[dropped];
+    const std::uint64_t remainder = decimal.digits % divisor;
+    decimal.digits = decimal.digits / divisor + (remainder >= divisor - remainder);
+}
+
+/*
+ * Value rounded to the given number of decimals, halves away from zero, trailing zeros
+ * dropped: 45.12345678 is written as 45.1234568 and 1.5 as 1.5 with 7 decimals.
+ * The significand times 10^decimals is exact in 128 bits, so the rounding is exact too
+ */
+inline char * writeDoubleFixed(char * out, double value, unsigned decimals) {
+    if(char * end = writeDoubleSignAndZero(out, value)) {
+        return end;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::int32_t biasedExponent = std::int32_t(bits >> 52);
+    std::uint64_t significand = bits & ((std::uint64_t(1) << 52) - 1);
+    std::int32_t shift = 1074;
+    if(biasedExponent != 0) {
+        significand |= std::uint64_t(1) << 52;
+        shift = 1075 - biasedExponent;
+    }
+    if(shift <= 0) {
+        // integers from 2^52, nothing to round
+        return writeDoubleShortest(out, value);
+    }
+    DecimalFloat decimal{0, -int(decimals)};
+    if(shift < 128) {
+        const unsigned __int128 scaled = static_cast<unsigned __int128>(significand) * PowersOfTen[decimals];
+        const unsigned __int128 integerPart = scaled >> shift;
+        if(integerPart >> 64 != 0) {
+            // the shortest form of such a big number has less than the requested decimals
+            return writeDoubleShortest(out, value);
+        }
+        const unsigned __int128 half = static_cast<unsigned __int128>(1) << (shift - 1);
+        decimal.digits = std::uint64_t(integerPart) + ((scaled & (2 * half - 1)) >= half);
+    }
+    return writeDecimalTrimmed(out, decimal);
+}
+
+// Shortest form rounded to the given number of significant digits, halves away from zero,
+// trailing zeros dropped
+inline char * writeDoubleSignificant(char * out, double value, unsigned significantDigits) {
+    if(char * end = writeDoubleSignAndZero(out, value)) {
+        return end;
+    }
+    DecimalFloat decimal = toShortestDecimal(value);
+    const int len = int(decimalDigitsCount(decimal.digits));
+    roundDecimal(decimal, decimal.exponent + len - int(significantDigits));
+    return writeDecimalTrimmed(out, decimal);
+}
+
+}
+}
+#endif // NUMBER_OPS_HPP
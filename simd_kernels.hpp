@@ -0,0 +1,435 @@
+// Block kernels for the hot scanning loops in string_ops.hpp, see simd_ops.hpp.
+// No include guard: included once per instruction set, inside its own namespace.
+// CPP_JSON_REFLECTION_KERNEL_LEVEL (a SimdLevel value) picks the code paths and
+// CPP_JSON_REFLECTION_KERNEL_TARGET the matching target attribute, both set by the includer:
+// GCC doesn't define __AVX2__ and others inside #pragma GCC target regions of C++ code
+#if !defined(CPP_JSON_REFLECTION_KERNEL_LEVEL) || !defined(CPP_JSON_REFLECTION_KERNEL_TARGET)
+#error "simd_kernels.hpp needs CPP_JSON_REFLECTION_KERNEL_LEVEL and CPP_JSON_REFLECTION_KERNEL_TARGET"
+#endif
+
+// the level the kernels below are compiled for, checked against the dispatch table
+inline constexpr SimdLevel compiledFor = SimdLevel(CPP_JSON_REFLECTION_KERNEL_LEVEL);
+
+[[gnu::noinline]] CPP_JSON_REFLECTION_KERNEL_TARGET inline const char * skipSpaces(const char * begin, const char * end) {
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 3 // AVX2
+    // whitespace chars have distinct low nibbles: ' ' 0x20, '\t' 0x09, '\n' 0x0A, '\r' 0x0D
+    const __m256i spaceTable = _mm256_setr_epi8(
+        ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+        ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1);
+    while(end - begin >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        __m256i isSpace = _mm256_cmpeq_epi8(_mm256_shuffle_epi8(spaceTable, chunk), chunk);
+        std::uint32_t notSpace = ~std::uint32_t(_mm256_movemask_epi8(isSpace));
+        if(notSpace != 0) {
+            return begin + trailingZeroes(notSpace);
+        }
+        begin += 32;
+    }
+#endif
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 1 // SSE2
+    while(end - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        __m128i isSpace = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))));
+        std::uint32_t notSpace = ~std::uint32_t(_mm_movemask_epi8(isSpace)) & 0xFFFF;
+        if(notSpace != 0) {
+            return begin + trailingZeroes(notSpace);
+        }
+        begin += 16;
+    }
+#endif
+    return begin;
+}
+
+// '"', '\\' or control char: the bytes which end a clean run inside a string
+CPP_JSON_REFLECTION_KERNEL_TARGET inline const char * findStringSpecial(const char * begin, const char * end) {
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 4 // AVX512
+    while(end - begin >= 64) {
+        __m512i chunk = _mm512_loadu_si512(begin);
+        std::uint64_t special = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('"'))
+                | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\\'))
+                | _mm512_cmplt_epu8_mask(chunk, _mm512_set1_epi8(0x20));
+        if(special != 0) {
+            return begin + trailingZeroes(special);
+        }
+        begin += 64;
+    }
+#endif
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 3 // AVX2
+    while(end - begin >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))),
+                    _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F)));
+        std::uint32_t mask = std::uint32_t(_mm256_movemask_epi8(special));
+        if(mask != 0) {
+            return begin + trailingZeroes(mask);
+        }
+        begin += 32;
+    }
+#endif
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 1 // SSE2
+    while(end - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))),
+                    _mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F)));
+        std::uint32_t mask = std::uint32_t(_mm_movemask_epi8(special));
+        if(mask != 0) {
+            return begin + trailingZeroes(mask);
+        }
+        begin += 16;
+    }
+#endif
+    return begin;
+}
+
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 1 // SSE2
+struct QuoteBackslashMasks {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+};
+
+CPP_JSON_REFLECTION_KERNEL_TARGET inline QuoteBackslashMasks quoteBackslashMasks64(const char * p) {
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 4 // AVX512
+    __m512i chunk = _mm512_loadu_si512(p);
+    return {
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('"')),
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\\'))
+    };
+#elif CPP_JSON_REFLECTION_KERNEL_LEVEL >= 3 // AVX2
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+    auto mask = [](__m256i lo, __m256i hi, char c) CPP_JSON_REFLECTION_KERNEL_TARGET -> std::uint64_t {
+        return std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, _mm256_set1_epi8(c))))
+                | (std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, _mm256_set1_epi8(c))))) << 32);
+    };
+    return {mask(lo, hi, '"'), mask(lo, hi, '\\')};
+#else
+    QuoteBackslashMasks ret{0, 0};
+    for(int i = 0; i < 4; i ++) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * 16));
+        ret.quote |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')))) << (i * 16);
+        ret.backslash |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')))) << (i * 16);
+    }
+    return ret;
+#endif
+}
+#endif
+
+// Bits of the chars escaped by a backslash, carrying an escape over the block border.
+// Odd-length backslash runs escape the next char; the run parity is found by adding
+// run starts to the runs (simdjson's find_escaped)
+CPP_JSON_REFLECTION_KERNEL_TARGET inline std::uint64_t escapedMask(std::uint64_t backslash, std::uint64_t & prevEscaped) {
+    constexpr std::uint64_t evenBits = 0x5555555555555555ULL;
+    backslash &= ~prevEscaped;
+    std::uint64_t followsEscape = backslash << 1 | prevEscaped;
+    std::uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+    std::uint64_t sequencesStartingOnEvenBits;
+    prevEscaped = __builtin_add_overflow(oddSequenceStarts, backslash, &sequencesStartingOnEvenBits);
+    std::uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+    return (evenBits ^ invertMask) & followsEscape;
+}
+
+// First '"' not escaped by a backslash, looked up in 64-byte blocks.
+// escapedCarry is set if the first char after the scanned blocks is escaped,
+// hasBackslashes if the scanned part contains escapes which still need validation
+CPP_JSON_REFLECTION_KERNEL_TARGET inline const char * findUnescapedQuote(const char * begin, const char * end, bool & escapedCarry, bool & hasBackslashes) {
+    escapedCarry = false;
+    hasBackslashes = false;
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 1 // SSE2
+    if(end - begin >= 16) {
+        // short strings (most of keys) usually end before the first backslash
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        std::uint32_t quotes = std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'))));
+        std::uint32_t backslashes = std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))));
+        if(quotes != 0 && (quotes & (backslashes - 1) & ~backslashes) != 0) {
+            return begin + trailingZeroes(quotes);
+        }
+    }
+    std::uint64_t prevEscaped = 0;
+    std::uint64_t anyBackslash = 0;
+    while(end - begin >= 64) {
+        QuoteBackslashMasks m = quoteBackslashMasks64(begin);
+        anyBackslash |= m.backslash;
+        std::uint64_t quotes = m.quote;
+        if(m.backslash | prevEscaped) {
+            quotes &= ~escapedMask(m.backslash, prevEscaped);
+        }
+        if(quotes != 0) {
+            hasBackslashes = anyBackslash != 0;
+            return begin + trailingZeroes(quotes);
+        }
+        begin += 64;
+    }
+    escapedCarry = prevEscaped != 0;
+    hasBackslashes = anyBackslash != 0;
+#endif
+    return begin;
+}
+
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 2 // SSE4_2
+/*
+ * UTF-8 validation by Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+ * Each byte is classified by three table lookups, by the nibbles of it and of the previous byte,
+ * which find all errors within two bytes; 3 and 4 byte sequences are checked by the continuations
+ * they require. Unlike the scanners above it checks the whole [begin, end), the tail block padded
+ * with spaces. Raw control chars are rejected too, strict JSON strings can't have them
+ */
+CPP_JSON_REFLECTION_KERNEL_TARGET inline bool isValidStringContent(const char * begin, const char * end) {
+    constexpr char TOO_SHORT = 1 << 0;      // lead byte or ASCII followed by a lead byte or ASCII
+    constexpr char TOO_LONG = 1 << 1;       // ASCII followed by a continuation
+    constexpr char OVERLONG_3 = 1 << 2;
+    constexpr char TOO_LARGE = 1 << 3;
+    constexpr char SURROGATE = 1 << 4;
+    constexpr char OVERLONG_2 = 1 << 5;
+    constexpr char TOO_LARGE_1000 = 1 << 6;
+    constexpr char OVERLONG_4 = 1 << 6;
+    constexpr char TWO_CONTS = char(1 << 7);
+    constexpr char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+    const __m128i byte1HighTable = _mm_setr_epi8(
+        // ASCII
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        // continuation
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        // 110_ and 1110 leads, 1111 leads
+        TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+    const __m128i byte1LowTable = _mm_setr_epi8(
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY, CARRY,
+        CARRY | TOO_LARGE, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000);
+    const __m128i byte2HighTable = _mm_setr_epi8(
+        // ASCII
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        // continuations 1000, 1001, 101_
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        // leads
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+    // a block ending with these needs continuations in the next one
+    const __m128i incompleteBound = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+
+    // most strings are printable ASCII, and the full check may start at any ASCII char
+    while(end - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+        if(_mm_movemask_epi8(_mm_or_si128(chunk, control)) != 0) {
+            break;
+        }
+        begin += 16;
+    }
+    if(end - begin < 16) {
+        while(begin != end && std::uint8_t(*begin - 0x20) < 0x60) {
+            begin ++;
+        }
+        if(begin == end) {
+            return true;
+        }
+    }
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prevInput = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+    auto check = [&](__m128i input) CPP_JSON_REFLECTION_KERNEL_TARGET {
+        error = _mm_or_si128(error, _mm_cmpeq_epi8(_mm_max_epu8(input, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F)));
+        if(_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, prevIncomplete);
+            prevIncomplete = _mm_setzero_si128();
+        } else {
+            __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+            __m128i special = _mm_and_si128(
+                        _mm_and_si128(
+                            _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibble)),
+                            _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, lowNibble))),
+                        _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble)));
+            // only 111_____ and 1111____ bytes two and three positions back get the high bit
+            __m128i isThirdByte = _mm_subs_epu8(_mm_alignr_epi8(input, prevInput, 14), _mm_set1_epi8(0xE0 - 0x80));
+            __m128i isFourthByte = _mm_subs_epu8(_mm_alignr_epi8(input, prevInput, 13), _mm_set1_epi8(char(0xF0 - 0x80)));
+            __m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(char(0x80)));
+            error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+            prevIncomplete = _mm_subs_epu8(input, incompleteBound);
+        }
+        prevInput = input;
+    };
+    while(end - begin >= 16) {
+        check(_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin)));
+        begin += 16;
+    }
+    alignas(16) char tail[16];
+    std::memset(tail, ' ', sizeof(tail));
+    std::memcpy(tail, begin, end - begin);
+    check(_mm_load_si128(reinterpret_cast<const __m128i *>(tail)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+#else
+// builds with no SSSE3 validate strings one code point at a time
+CPP_JSON_REFLECTION_KERNEL_TARGET inline bool isValidStringContent(const char * begin, const char * end) {
+    const unsigned char * p = reinterpret_cast<const unsigned char *>(begin);
+    const unsigned char * e = reinterpret_cast<const unsigned char *>(end);
+    while(p != e) {
+        unsigned char c = *p;
+        if(c < 0x80) {
+            if(c < 0x20) {
+                return false;
+            }
+            p ++;
+            continue;
+        }
+        std::ptrdiff_t continuations;
+        std::uint32_t codePoint;
+        std::uint32_t minCodePoint;
+        if((c & 0xE0) == 0xC0) {
+            continuations = 1, codePoint = c & 0x1F, minCodePoint = 0x80;
+        } else if((c & 0xF0) == 0xE0) {
+            continuations = 2, codePoint = c & 0x0F, minCodePoint = 0x800;
+        } else if((c & 0xF8) == 0xF0) {
+            continuations = 3, codePoint = c & 0x07, minCodePoint = 0x10000;
+        } else {
+            return false;
+        }
+        if(e - p <= continuations) {
+            return false;
+        }
+        for(std::ptrdiff_t i = 1; i <= continuations; i ++) {
+            if((p[i] & 0xC0) != 0x80) {
+                return false;
+            }
+            codePoint = codePoint << 6 | (p[i] & 0x3F);
+        }
+        // overlong forms, surrogates and code points past Unicode
+        if(codePoint < minCodePoint || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return false;
+        }
+        p += continuations + 1;
+    }
+    return true;
+}
+#endif
+
+struct BlockMasks {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    // {}[]:,
+    std::uint64_t op;
+    std::uint64_t space;
+};
+
+// '[' and ']' are the only chars besides '{' and '}' which turn into them with the 0x20 bit set
+CPP_JSON_REFLECTION_KERNEL_TARGET inline BlockMasks classifyBlock64(const char * p) {
+#if CPP_JSON_REFLECTION_KERNEL_LEVEL >= 4 // AVX512
+    __m512i chunk = _mm512_loadu_si512(p);
+    __m512i lower = _mm512_or_si512(chunk, _mm512_set1_epi8(0x20));
+    return {
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('"')),
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\\')),
+        _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('{')) | _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('}'))
+            | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(',')) | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(':')),
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(' ')) | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\n'))
+            | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\r')) | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\t'))
+    };
+#elif CPP_JSON_REFLECTION_KERNEL_LEVEL >= 3 // AVX2
+    const __m256i spaceTable = _mm256_setr_epi8(
+        ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+        ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1);
+    BlockMasks ret{0, 0, 0, 0};
+    for(int i = 0; i < 2; i ++) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * 32));
+        __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        __m256i op = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':'))));
+        __m256i space = _mm256_cmpeq_epi8(_mm256_shuffle_epi8(spaceTable, chunk), chunk);
+        ret.quote |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'))))) << (i * 32);
+        ret.backslash |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))))) << (i * 32);
+        ret.op |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(op))) << (i * 32);
+        ret.space |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(space))) << (i * 32);
+    }
+    return ret;
+#elif CPP_JSON_REFLECTION_KERNEL_LEVEL >= 1 // SSE2
+    BlockMasks ret{0, 0, 0, 0};
+    for(int i = 0; i < 4; i ++) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * 16));
+        __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(',')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(':'))));
+        __m128i space = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))));
+        ret.quote |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')))) << (i * 16);
+        ret.backslash |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')))) << (i * 16);
+        ret.op |= std::uint64_t(_mm_movemask_epi8(op)) << (i * 16);
+        ret.space |= std::uint64_t(_mm_movemask_epi8(space)) << (i * 16);
+    }
+    return ret;
+#else
+    BlockMasks ret{0, 0, 0, 0};
+    for(int i = 0; i < 64; i ++) {
+        std::uint64_t bit = std::uint64_t(1) << i;
+        switch(p[i]) {
+        case '"': ret.quote |= bit; break;
+        case '\\': ret.backslash |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',': ret.op |= bit; break;
+        case ' ': case '\n': case '\r': case '\t': ret.space |= bit; break;
+        }
+    }
+    return ret;
+#endif
+}
+
+// Stage 1 of DeserializeIndexed(): bits of structural chars outside strings, of unescaped quotes,
+// of backslashes starting escapes and of the first chars of scalars (non-whitespace after
+// whitespace, a structural char or a quote) in the 64-byte block at p
+CPP_JSON_REFLECTION_KERNEL_TARGET inline std::uint64_t blockStructurals(const char * p, IndexCarry & carry) {
+    BlockMasks m = classifyBlock64(p);
+    std::uint64_t quote = m.quote;
+    std::uint64_t escapeStarts = 0;
+    if(m.backslash | carry.prevEscaped) {
+        std::uint64_t escaped = escapedMask(m.backslash, carry.prevEscaped);
+        quote &= ~escaped;
+        escapeStarts = m.backslash & ~escaped;
+    }
+    std::uint64_t inString = prefixXor(quote) ^ carry.inString;
+    carry.inString = std::uint64_t(std::int64_t(inString) >> 63);
+    // spaces and ops inside strings may only precede the closing quote, which is a boundary itself
+    std::uint64_t boundary = m.op | m.space | quote;
+    std::uint64_t followsBoundary = boundary << 1 | carry.prevBoundary;
+    carry.prevBoundary = boundary >> 63;
+    return ((m.op | (~boundary & followsBoundary)) & ~inString) | quote | escapeStarts;
+}
+
+// Offsets from base of the structurals in whole 64-byte blocks, returns the end of the written offsets;
+// the caller keeps them under 4 GB
+[[gnu::noinline]] CPP_JSON_REFLECTION_KERNEL_TARGET inline std::uint32_t * indexStructurals(const char * begin, const char * end, const char * base, std::uint32_t * out, IndexCarry & carry) {
+    while(end - begin >= 64) {
+        std::uint64_t structurals = blockStructurals(begin, carry);
+        std::uint32_t blockOffset = std::uint32_t(begin - base);
+        // exactly one offset per set bit, the output is sized on that
+        while(structurals != 0) {
+            *out++ = blockOffset + std::uint32_t(trailingZeroes(structurals));
+            structurals &= structurals - 1;
+        }
+        begin += 64;
+    }
+    return out;
+}
+
+// Number of the structurals in whole 64-byte blocks, to size the output before indexing them
+[[gnu::noinline]] CPP_JSON_REFLECTION_KERNEL_TARGET inline std::size_t countStructurals(const char * begin, const char * end, IndexCarry & carry) {
+    std::size_t count = 0;
+    while(end - begin >= 64) {
+        count += __builtin_popcountll(blockStructurals(begin, carry));
+        begin += 64;
+    }
+    return count;
+}
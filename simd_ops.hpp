@@ -0,0 +1,226 @@
+#ifndef SIMD_OPS_HPP
+#define SIMD_OPS_HPP
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+
+// GCC only: Clang defines __GNUC__ too, but its builds are not tested with runtime dispatch
+#if defined(CPP_JSON_REFLECTION_RUNTIME_DISPATCH) && defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define CPP_JSON_REFLECTION_DISPATCH_KERNELS
+#endif
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__) || defined(CPP_JSON_REFLECTION_DISPATCH_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace JSONReflection {
+
+// Instruction sets of the scanning kernels. SSE4_2 level kernels use up to SSSE3, AVX512 ones AVX-512BW
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    SSE4_2,
+    AVX2,
+    AVX512
+};
+
+namespace d {
+namespace simd {
+
+/*
+ * Block kernels for the hot scanning loops in string_ops.hpp.
+ * Every kernel consumes only whole blocks inside [begin, end) and returns either
+ * the position of the first interesting byte, or the position where less than one
+ * block of data remains. Scalar code continues from the returned position, so
+ * it stays the single source of truth about JSON grammar and end-of-data handling.
+ */
+
+inline unsigned trailingZeroes(std::uint32_t v) {
+    return __builtin_ctz(v);
+}
+
+inline unsigned trailingZeroes(std::uint64_t v) {
+    return __builtin_ctzll(v);
+}
+
+// Bit i is the xor of bits 0..i: with quote bits, the mask of string contents with opening quotes
+inline std::uint64_t prefixXor(std::uint64_t v) {
+    v ^= v << 1;
+    v ^= v << 2;
+    v ^= v << 4;
+    v ^= v << 8;
+    v ^= v << 16;
+    v ^= v << 32;
+    return v;
+}
+
+// State of structural indexing carried from one 64-byte block to the next
+struct IndexCarry {
+    std::uint64_t prevEscaped = 0;
+    // all ones if the next block starts inside a string
+    std::uint64_t inString = 0;
+    // the last char was whitespace, structural char or quote, so the next one may start a scalar
+    std::uint64_t prevBoundary = 1;
+};
+
+#if !defined(CPP_JSON_REFLECTION_DISPATCH_KERNELS)
+
+// the kernel level macro holds the value of SimdLevel
+#if defined(__AVX512BW__)
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 4
+#elif defined(__AVX2__)
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 3
+#elif defined(__SSSE3__)
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 2
+#elif defined(__SSE2__)
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 1
+#else
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 0
+#endif
+#define CPP_JSON_REFLECTION_KERNEL_TARGET
+#include "simd_kernels.hpp"
+#undef CPP_JSON_REFLECTION_KERNEL_TARGET
+#undef CPP_JSON_REFLECTION_KERNEL_LEVEL
+
+#else
+
+/*
+ * CPP_JSON_REFLECTION_RUNTIME_DISPATCH: kernels are compiled for every level and picked by
+ * the CPU at the first use, so one binary built for the baseline x86-64 runs the AVX2 or
+ * AVX-512 ones where they are available. Every call goes through a function pointer.
+ * The kernels get the instruction sets by target attributes, not by the compiler options
+ */
+#define CPP_JSON_REFLECTION_KERNEL_TARGET
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 1
+namespace baseline {
+#include "simd_kernels.hpp"
+}
+#undef CPP_JSON_REFLECTION_KERNEL_LEVEL
+#undef CPP_JSON_REFLECTION_KERNEL_TARGET
+#define CPP_JSON_REFLECTION_KERNEL_TARGET __attribute__((target("sse4.2")))
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 2
+namespace sse4_2 {
+#include "simd_kernels.hpp"
+}
+#undef CPP_JSON_REFLECTION_KERNEL_LEVEL
+#undef CPP_JSON_REFLECTION_KERNEL_TARGET
+#define CPP_JSON_REFLECTION_KERNEL_TARGET __attribute__((target("avx2")))
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 3
+namespace avx2 {
+#include "simd_kernels.hpp"
+}
+#undef CPP_JSON_REFLECTION_KERNEL_LEVEL
+#undef CPP_JSON_REFLECTION_KERNEL_TARGET
+#define CPP_JSON_REFLECTION_KERNEL_TARGET __attribute__((target("avx512f,avx512bw,avx2")))
+#define CPP_JSON_REFLECTION_KERNEL_LEVEL 4
+namespace avx512 {
+#include "simd_kernels.hpp"
+}
+#undef CPP_JSON_REFLECTION_KERNEL_LEVEL
+#undef CPP_JSON_REFLECTION_KERNEL_TARGET
+
+struct Kernels {
+    SimdLevel level;
+    const char * (*skipSpaces)(const char * begin, const char * end);
+    const char * (*findStringSpecial)(const char * begin, const char * end);
+    const char * (*findUnescapedQuote)(const char * begin, const char * end, bool & escapedCarry, bool & hasBackslashes);
+    bool (*isValidStringContent)(const char * begin, const char * end);
+    std::uint32_t * (*indexStructurals)(const char * begin, const char * end, const char * base, std::uint32_t * out, IndexCarry & carry);
+    std::size_t (*countStructurals)(const char * begin, const char * end, IndexCarry & carry);
+};
+
+#define CPP_JSON_REFLECTION_KERNELS(ns) \
+    Kernels{ns::compiledFor, &ns::skipSpaces, &ns::findStringSpecial, &ns::findUnescapedQuote, &ns::isValidStringContent, &ns::indexStructurals, &ns::countStructurals}
+// indexed by SimdLevel from SSE2, the x86-64 baseline
+inline constexpr Kernels levelKernels[] = {
+    CPP_JSON_REFLECTION_KERNELS(baseline),
+    CPP_JSON_REFLECTION_KERNELS(sse4_2),
+    CPP_JSON_REFLECTION_KERNELS(avx2),
+    CPP_JSON_REFLECTION_KERNELS(avx512),
+};
+#undef CPP_JSON_REFLECTION_KERNELS
+// a kernel set compiled for another level than its entry would silently run slower code
+static_assert(levelKernels[0].level == SimdLevel::SSE2 && levelKernels[1].level == SimdLevel::SSE4_2
+        && levelKernels[2].level == SimdLevel::AVX2 && levelKernels[3].level == SimdLevel::AVX512);
+
+inline bool cpuSupports(SimdLevel level) {
+    __builtin_cpu_init();
+    switch(level) {
+    case SimdLevel::SCALAR:
+    case SimdLevel::SSE2:
+        return true;
+    case SimdLevel::SSE4_2:
+        return __builtin_cpu_supports("sse4.2");
+    case SimdLevel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case SimdLevel::AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+}
+
+inline const Kernels * bestKernels() {
+    for(SimdLevel level: {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE4_2}) {
+        if(cpuSupports(level)) {
+            return &levelKernels[int(level) - int(SimdLevel::SSE2)];
+        }
+    }
+    return &levelKernels[0];
+}
+
+// a relaxed load is a plain read, the table is chosen once
+inline std::atomic<const Kernels *> & activeKernels() {
+    static std::atomic<const Kernels *> active{bestKernels()};
+    return active;
+}
+
+inline const char * skipSpaces(const char * begin, const char * end) {
+    return activeKernels().load(std::memory_order_relaxed)->skipSpaces(begin, end);
+}
+inline const char * findStringSpecial(const char * begin, const char * end) {
+    return activeKernels().load(std::memory_order_relaxed)->findStringSpecial(begin, end);
+}
+inline const char * findUnescapedQuote(const char * begin, const char * end, bool & escapedCarry, bool & hasBackslashes) {
+    return activeKernels().load(std::memory_order_relaxed)->findUnescapedQuote(begin, end, escapedCarry, hasBackslashes);
+}
+inline bool isValidStringContent(const char * begin, const char * end) {
+    return activeKernels().load(std::memory_order_relaxed)->isValidStringContent(begin, end);
+}
+inline std::uint32_t * indexStructurals(const char * begin, const char * end, const char * base, std::uint32_t * out, IndexCarry & carry) {
+    return activeKernels().load(std::memory_order_relaxed)->indexStructurals(begin, end, base, out, carry);
+}
+inline std::size_t countStructurals(const char * begin, const char * end, IndexCarry & carry) {
+    return activeKernels().load(std::memory_order_relaxed)->countStructurals(begin, end, carry);
+}
+
+#endif
+
+}
+}
+
+// The instruction set the scanning kernels run with
+inline SimdLevel simdLevel() {
+#if defined(CPP_JSON_REFLECTION_DISPATCH_KERNELS)
+    return d::simd::activeKernels().load(std::memory_order_relaxed)->level;
+#else
+    return d::simd::compiledFor;
+#endif
+}
+
+// Forces the kernels of the given level, to test or benchmark them all on one machine.
+// False if the CPU can't run them, or if they are not compiled in: without
+// CPP_JSON_REFLECTION_RUNTIME_DISPATCH the only level is the one the build targets
+inline bool setSimdLevel(SimdLevel level) {
+#if defined(CPP_JSON_REFLECTION_DISPATCH_KERNELS)
+    if(level == SimdLevel::SCALAR || !d::simd::cpuSupports(level)) {
+        return false;
+    }
+    d::simd::activeKernels().store(&d::simd::levelKernels[int(level) - int(SimdLevel::SSE2)], std::memory_order_relaxed);
+    return true;
+#else
+    return level == simdLevel();
+#endif
+}
+
+}
+#endif // SIMD_OPS_HPP
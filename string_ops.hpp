@@ -1,5 +1,12 @@
 #include <iterator>
 #include <ranges>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <compare>
+#include <limits>
+#include "simd_ops.hpp"
+#include "structural_index.hpp"
 namespace JSONReflection {
 
 template<typename InpIter>
@@ -17,10 +24,90 @@ template<typename T>
 concept StringOutputContainerConcept =  std::ranges::output_range<T, char> && std::ranges::forward_range<T>
         && std::same_as<std::ranges::range_value_t<T>, char>;
 
+// Output callback which also gives a raw window to write into: reserve(n) returns room
+// for at least n chars, commit(n) accepts n of them. Numbers and strings are written
+// straight into the window instead of a temporary buffer
+template <typename T>
+concept SerializerWriterConcept = SerializerOutputCallbackConcept<T> && requires (T w, std::size_t n) {
+    {w.reserve(n)} -> std::same_as<char *>;
+    w.commit(n);
+};
+
+template<typename T>
+concept ResizableCharContainerConcept = requires (T c, std::size_t n) {
+    requires std::same_as<typename T::value_type, char>;
+    c.resize(n);
+    {c.data()} -> std::same_as<char *>;
+    {c.size()} -> std::convertible_to<std::size_t>;
+};
+
+// Tag for Serialize(container, ExactSize): size the output first, then write it with no checks
+struct ExactSizeT {};
+inline constexpr ExactSizeT ExactSize{};
+
+// Room past the output end for writing with no checks. Strings and integers write exactly their
+// chars; double formatters may overwrite up to 32 chars from the number start, so at most 31 past
+// the output end. Twice that is kept
+inline constexpr std::size_t UncheckedSlack = 64;
+
+// Writer appending to a std::string like container, which grows geometrically;
+// the container gets its final size in the destructor
+template <ResizableCharContainerConcept ContainerT>
+class ContainerWriter {
+    ContainerT & container;
+    std::size_t pos;
+
+    [[gnu::noinline]] void grow(std::size_t n) {
+        std::size_t newSize = std::max<std::size_t>({container.size() * 2, pos + n, 256});
+#if defined(__cpp_lib_string_resize_and_overwrite)
+        if constexpr (requires { container.resize_and_overwrite(newSize, [](char *, std::size_t s) { return s; }); }) {
+            // no zero filling, every char up to pos is written before the final resize
+            container.resize_and_overwrite(newSize, [](char *, std::size_t s) { return s; });
+            return;
+        }
+#endif
+        container.resize(newSize);
+    }
+public:
+    explicit ContainerWriter(ContainerT & c): container(c), pos(c.size()) {}
+    ContainerWriter(const ContainerWriter &) = delete;
+    ContainerWriter & operator=(const ContainerWriter &) = delete;
+    ~ContainerWriter() {
+        container.resize(pos);
+    }
+
+    char * reserve(std::size_t n) {
+        if(n > container.size() - pos) [[unlikely]] {
+            grow(n);
+        }
+        return container.data() + pos;
+    }
+    void commit(std::size_t n) {
+        pos += n;
+    }
+    bool operator()(const char * data, std::size_t size) {
+        std::memcpy(reserve(size), data, size);
+        commit(size);
+        return true;
+    }
+};
+
+// DeserializePadded() input is followed by this many readable bytes, the first of them zero
+inline constexpr std::size_t DeserializePadding = 64;
+
 enum class ParseFlags: std::uint32_t {
     DEFAULT = 0,
     EXCESS_FIELDS_PROHIBITED = std::underlying_type_t<ParseFlags>(1) << 1,
     ALL_FIELDS_REQUIRED =      std::underlying_type_t<ParseFlags>(1) << 2,
+    // Predict object keys in the order they came in the previous object of the same type,
+    // instead of the declaration order. Remembered per J<T> type and per thread
+    LEARN_KEY_ORDER =          std::underlying_type_t<ParseFlags>(1) << 3,
+    // Input produced by this library's Serialize, like traffic between own services: parsed
+    // with no validation of escapes, literals and skipped numbers. Undefined on malformed input
+    TRUSTED_INPUT =            std::underlying_type_t<ParseFlags>(1) << 4,
+    // Reject everything RFC 8259 doesn't allow: missing or trailing commas, data after the root
+    // object, invalid UTF-8 and raw control chars in strings. Takes precedence over TRUSTED_INPUT
+    STRICT =                   std::underlying_type_t<ParseFlags>(1) << 5,
 };
 
 inline constexpr ParseFlags operator| (const ParseFlags &l, const ParseFlags &r) {
@@ -41,7 +128,9 @@ public:
         SKIPPING_ERROR,
         FIXED_SIZE_CONTAINER_UNDERFLOW,
         EXCESS_FIELD,
-        MISSING_FIELD
+        MISSING_FIELD,
+        INTEGER_OVERFLOW,
+        ILLFORMED_STRING
     };
 
 private:
@@ -68,6 +157,22 @@ public:
     bool flag(ParseFlags flag) {
         return static_cast<std::underlying_type_t<ParseFlags>>(m_flags) & static_cast<std::underlying_type_t<ParseFlags>>(flag);
     }
+
+    // How object keys were found: matched as the predicted next key (see LEARN_KEY_ORDER),
+    // looked up, or not found at all (excess keys)
+    struct KeyMatchStats {
+        std::size_t predicted = 0;
+        std::size_t lookedUp = 0;
+        std::size_t unknown = 0;
+    };
+    void countKeyMatch(std::size_t KeyMatchStats::* counter) {
+        keyStats.*counter += 1;
+    }
+    KeyMatchStats keyMatchStats() const {
+        return keyStats;
+    }
+private:
+    KeyMatchStats keyStats;
 };
 
 namespace d {
@@ -80,66 +185,302 @@ concept DynamicContainerTypeConcept = requires (T  v) {
         v.clear();
 };
 
+enum class Validation {
+    REGULAR,
+    // ParseFlags::TRUSTED_INPUT: escapes, literals and skipped numbers are not validated
+    TRUSTED,
+    // ParseFlags::STRICT: RFC 8259 separators, UTF-8 and no raw control chars in strings
+    STRICT
+};
+
+/*
+ * Pointer iterator carrying the input mode, so parsers are instantiated for it at compile time.
+ * Padded: DeserializePadded() input; parsers rely on the zero byte at the end, which stops
+ * every token, and run block kernels into the padding, so the end is checked at structural chars only.
+ */
+template <bool Padded, Validation V>
+class RawInputIterator {
+    const char * p;
+public:
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = char;
+    using element_type = const char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char *;
+    using reference = const char &;
+
+    constexpr RawInputIterator() noexcept: p(nullptr) {}
+    constexpr explicit RawInputIterator(const char * ptr) noexcept: p(ptr) {}
+
+    constexpr reference operator*() const noexcept { return *p; }
+    constexpr pointer operator->() const noexcept { return p; }
+    constexpr reference operator[](difference_type n) const noexcept { return p[n]; }
+
+    constexpr RawInputIterator & operator++() noexcept { ++p; return *this; }
+    constexpr RawInputIterator operator++(int) noexcept { return RawInputIterator(p++); }
+    constexpr RawInputIterator & operator--() noexcept { --p; return *this; }
+    constexpr RawInputIterator operator--(int) noexcept { return RawInputIterator(p--); }
+    constexpr RawInputIterator & operator+=(difference_type n) noexcept { p += n; return *this; }
+    constexpr RawInputIterator & operator-=(difference_type n) noexcept { p -= n; return *this; }
+    constexpr RawInputIterator operator+(difference_type n) const noexcept { return RawInputIterator(p + n); }
+    friend constexpr RawInputIterator operator+(difference_type n, const RawInputIterator & i) noexcept { return RawInputIterator(i.p + n); }
+    constexpr RawInputIterator operator-(difference_type n) const noexcept { return RawInputIterator(p - n); }
+    friend constexpr difference_type operator-(const RawInputIterator & a, const RawInputIterator & b) noexcept { return a.p - b.p; }
+
+    friend constexpr bool operator==(const RawInputIterator & a, const RawInputIterator & b) noexcept { return a.p == b.p; }
+    friend constexpr std::strong_ordering operator<=>(const RawInputIterator & a, const RawInputIterator & b) noexcept { return a.p <=> b.p; }
+};
+static_assert(InputIteratorConcept<RawInputIterator<true, Validation::STRICT>>);
+
+// DeserializeIndexed() input: a pointer iterator with the cursor in the structural index of the input
+template <Validation V>
+class IndexedInputIterator {
+    const char * p;
+    StructuralCursor * s;
+public:
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = char;
+    using element_type = const char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char *;
+    using reference = const char &;
+
+    constexpr IndexedInputIterator() noexcept: p(nullptr), s(nullptr) {}
+    constexpr IndexedInputIterator(const char * ptr, StructuralCursor * cursor) noexcept: p(ptr), s(cursor) {}
+
+    StructuralCursor & structurals() const noexcept { return *s; }
+
+    constexpr reference operator*() const noexcept { return *p; }
+    constexpr pointer operator->() const noexcept { return p; }
+    constexpr reference operator[](difference_type n) const noexcept { return p[n]; }
+
+    constexpr IndexedInputIterator & operator++() noexcept { ++p; return *this; }
+    constexpr IndexedInputIterator operator++(int) noexcept { return IndexedInputIterator(p++, s); }
+    constexpr IndexedInputIterator & operator--() noexcept { --p; return *this; }
+    constexpr IndexedInputIterator operator--(int) noexcept { return IndexedInputIterator(p--, s); }
+    constexpr IndexedInputIterator & operator+=(difference_type n) noexcept { p += n; return *this; }
+    constexpr IndexedInputIterator & operator-=(difference_type n) noexcept { p -= n; return *this; }
+    constexpr IndexedInputIterator operator+(difference_type n) const noexcept { return IndexedInputIterator(p + n, s); }
+    friend constexpr IndexedInputIterator operator+(difference_type n, const IndexedInputIterator & i) noexcept { return IndexedInputIterator(i.p + n, i.s); }
+    constexpr IndexedInputIterator operator-(difference_type n) const noexcept { return IndexedInputIterator(p - n, s); }
+    friend constexpr difference_type operator-(const IndexedInputIterator & a, const IndexedInputIterator & b) noexcept { return a.p - b.p; }
+
+    friend constexpr bool operator==(const IndexedInputIterator & a, const IndexedInputIterator & b) noexcept { return a.p == b.p; }
+    friend constexpr std::strong_ordering operator<=>(const IndexedInputIterator & a, const IndexedInputIterator & b) noexcept { return a.p <=> b.p; }
+};
+static_assert(InputIteratorConcept<IndexedInputIterator<Validation::STRICT>>);
+
+template <class InpIter>
+struct InputMode {
+    static constexpr bool padded = false;
+    static constexpr bool indexed = false;
+    static constexpr Validation validation = Validation::REGULAR;
+};
+template <bool Padded, Validation V>
+struct InputMode<RawInputIterator<Padded, V>> {
+    static constexpr bool padded = Padded;
+    static constexpr bool indexed = false;
+    static constexpr Validation validation = V;
+};
+template <Validation V>
+struct InputMode<IndexedInputIterator<V>> {
+    static constexpr bool padded = false;
+    static constexpr bool indexed = true;
+    static constexpr Validation validation = V;
+};
+
+template <class InpIter>
+constexpr bool isPadded = InputMode<std::decay_t<InpIter>>::padded;
+template <class InpIter>
+constexpr bool isTrusted = InputMode<std::decay_t<InpIter>>::validation == Validation::TRUSTED;
+template <class InpIter>
+constexpr bool isIndexed = InputMode<std::decay_t<InpIter>>::indexed;
+template <class InpIter>
+constexpr bool isStrict = InputMode<std::decay_t<InpIter>>::validation == Validation::STRICT;
+
+// How far block kernels may read: padded input stays readable past the end
+template <class InpIter>
+const char * scanLimit(const InpIter & end) {
+    if constexpr(isPadded<InpIter>) {
+        return std::to_address(end) + DeserializePadding;
+    } else {
+        return std::to_address(end);
+    }
+}
+
+inline bool needsEscaping(char c) {
+    return c == '"' || c == '\\' || std::uint8_t(c) < 0x20;
+}
+
+// Writes the JSON escape sequence for c to out, returns its length (2 or 6)
+inline std::size_t writeEscaped(char c, char * out) {
+    out[0] = '\\';
+    switch(c) {
+    case '"':  out[1] = '"';  return 2;
+    case '\\': out[1] = '\\'; return 2;
+    case '\b': out[1] = 'b';  return 2;
+    case '\f': out[1] = 'f';  return 2;
+    case '\r': out[1] = 'r';  return 2;
+    case '\n': out[1] = 'n';  return 2;
+    case '\t': out[1] = 't';  return 2;
+    default:
+    {
+        constexpr char hex[] = "0123456789abcdef";
+        out[1] = 'u';
+        out[2] = '0';
+        out[3] = '0';
+        out[4] = hex[std::uint8_t(c) >> 4];
+        out[5] = hex[std::uint8_t(c) & 0xF];
+        return 6;
+    }
+    }
+}
+
+// Clean runs are found blockwise; escapes and short runs are collected in a staging
+// buffer so callback gets large chunks instead of one call per escape
 template<class ClbT> requires  SerializerOutputCallbackConcept<ClbT>
 bool outputEscapedString(const char *data, std::size_t size, ClbT && clb) {
-    const char *segStart = data;
-    std::size_t segSize = 0;
-    std::size_t counter = 0;
-    char toOutEscaped [2] = {'\\', ' '};
-    while(counter < size) {
-        switch(segStart[segSize]) {
-            case '"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\r':
-            case '\n':
-            case '\t':
-        {
-
-            switch(segStart[segSize]) {
-            case '"':  toOutEscaped[1] = '"';  break;
-            case '\\': toOutEscaped[1] = '\\'; break;
-            case '\b': toOutEscaped[1] = 'b';  break;
-            case '\f': toOutEscaped[1] = 'f';  break;
-            case '\r': toOutEscaped[1] = 'r';  break;
-            case '\n': toOutEscaped[1] = 'n';  break;
-            case '\t': toOutEscaped[1] = 't';  break;
-            default:
-                toOutEscaped[1] == 0;
-            }
+    const char * end = data + size;
+    auto findSpecial = [end](const char * from) {
+        from = simd::findStringSpecial(from, end);
+        while(from != end && !needsEscaping(*from)) from ++;
+        return from;
+    };
+    const char * special = findSpecial(data);
+    if(special == end) [[likely]] {
+        return size == 0 || clb(data, size);
+    }
 
-            if(segSize > 0) {
-                if(!clb(segStart, segSize))  [[unlikely]] {
-                    return false;
-                }
+    constexpr std::size_t StagingSize = 256;
+    char staging[StagingSize];
+    std::size_t staged = 0;
+    while(true) {
+        std::size_t run = special - data;
+        if(run > StagingSize - staged) {
+            if(staged > 0 && !clb(staging, staged)) [[unlikely]] {
+                return false;
             }
-            if(toOutEscaped[1] != 0) [[likely]] {
-                if(!clb(toOutEscaped, 2))  [[unlikely]] {
-                    return false;
-                }
+            staged = 0;
+            if(!clb(data, run)) [[unlikely]] {
+                return false;
             }
-            segSize = 0;
-            segStart = data + counter + 1;
+        } else {
+            std::memcpy(staging + staged, data, run);
+            staged += run;
+        }
+        if(special == end) {
             break;
         }
-        default:
-        {
-            if(std::uint8_t(segStart[segSize]) < 32) [[unlikely]] {
+        if(StagingSize - staged < 6) {
+            if(!clb(staging, staged)) [[unlikely]] {
                 return false;
             }
-            segSize ++;
-            break;
+            staged = 0;
         }
-        }
-        counter++;
+        staged += writeEscaped(*special, staging + staged);
+        data = special + 1;
+        special = findSpecial(data);
     }
-    if(segSize > 0) {
-        if(!clb(segStart, segSize))  [[unlikely]] {
-            return false;
+    if(staged > 0) {
+        return clb(staging, staged);
+    }
+    return true;
+}
+
+// Writer which only counts the output size. Numbers are still formatted, into a scratch
+// buffer, to know their width; escaped strings are counted without writing
+class SizeCounter {
+    std::size_t count = 0;
+    char scratch[64];
+public:
+    // n is at most 50, the widest number
+    char * reserve(std::size_t) {
+        return scratch;
+    }
+    void commit(std::size_t n) {
+        count += n;
+    }
+    bool operator()(const char *, std::size_t size) {
+        count += size;
+        return true;
+    }
+    std::size_t size() const {
+        return count;
+    }
+};
+
+// Writer for a buffer known to be large enough, see SerializedSize()
+class UncheckedWriter {
+    char * begin;
+    char * p;
+public:
+    static constexpr std::size_t Slack = UncheckedSlack;
+
+    explicit UncheckedWriter(char * out): begin(out), p(out) {}
+    char * reserve(std::size_t) {
+        return p;
+    }
+    void commit(std::size_t n) {
+        p += n;
+    }
+    bool operator()(const char * data, std::size_t size) {
+        std::memcpy(p, data, size);
+        p += size;
+        return true;
+    }
+    std::size_t size() const {
+        return p - begin;
+    }
+};
+
+inline std::size_t escapedStringSize(const char *data, std::size_t size) {
+    const char * end = data + size;
+    while(true) {
+        data = simd::findStringSpecial(data, end);
+        while(data != end && !needsEscaping(*data)) data ++;
+        if(data == end) {
+            return size;
+        }
+        switch(*data) {
+        case '"': case '\\': case '\b': case '\f': case '\r': case '\n': case '\t':
+            size += 1;
+            break;
+        default:
+            size += 5;
         }
+        data ++;
     }
+}
 
+// Escaped string straight into the writer window; at most 6 output chars per input char
+template<class WriterT> requires SerializerWriterConcept<WriterT>
+bool writeEscapedString(const char *data, std::size_t size, WriterT & writer) {
+    if constexpr (std::same_as<WriterT, SizeCounter>) {
+        writer.commit(escapedStringSize(data, size));
+        return true;
+    }
+    constexpr std::size_t ChunkSize = 4096;
+    const char * end = data + size;
+    while(data != end) {
+        const char * chunkEnd = data + std::min<std::size_t>(end - data, ChunkSize);
+        char * out = writer.reserve((chunkEnd - data) * 6);
+        char * p = out;
+        while(true) {
+            const char * special = simd::findStringSpecial(data, chunkEnd);
+            while(special != chunkEnd && !needsEscaping(*special)) special ++;
+            std::memcpy(p, data, special - data);
+            p += special - data;
+            data = special;
+            if(special == chunkEnd) {
+                break;
+            }
+            p += writeEscaped(*special, p);
+            data ++;
+        }
+        writer.commit(p - out);
+    }
     return true;
 }
 
@@ -172,13 +513,28 @@ inline bool skipWhiteSpace(InputIteratorConcept auto & begin, const InputIterato
         ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
         return false;
     }
-    while(isSpace(*begin)) {
-        begin ++;
-        if(begin == end) [[unlikely]] {
-            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
-            break;
+    if(!isSpace(*begin)) [[likely]] {
+        return true;
+    }
+    constexpr bool padded = isPadded<decltype(begin)>;
+    begin ++;
+    if((padded || begin != end) && !isSpace(*begin)) {
+        return true;
+    }
+    const char * spaceRunBegin = std::to_address(begin);
+    if constexpr(isIndexed<decltype(begin)>) {
+        // every token after whitespace is indexed
+        begin += begin.structurals().seek(spaceRunBegin) - spaceRunBegin;
+    } else {
+        begin += simd::skipSpaces(spaceRunBegin, scanLimit(end)) - spaceRunBegin;
+        while((padded || begin != end) && isSpace(*begin)) {
+            begin ++;
         }
     }
+    if(begin == end) [[unlikely]] {
+        ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
+        return false;
+    }
     return true;
 }
 
@@ -199,47 +555,194 @@ inline bool skipWhiteSpaceTill(InputIteratorConcept auto & begin, const InputIte
     }
 }
 
+// After an array item or an object member: steps over the comma, the closing bracket is left
+// to the caller. Strict input needs exactly one comma between values and none before the bracket
+template<class InpIter> requires InputIteratorConcept<InpIter>
+bool skipValueSeparator(InpIter & begin, const InpIter & end, char closing, DeserializationContext & ctx) {
+    if(*begin == ',') {
+        begin ++;
+        if constexpr(isStrict<InpIter>) {
+            if(!skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
+                return false;
+            }
+            if(*begin == closing) [[unlikely]] {
+                ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - begin);
+                return false;
+            }
+        }
+    } else if constexpr(isStrict<InpIter>) {
+        if(*begin != closing) [[unlikely]] {
+            ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - begin);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Strict input strings are valid UTF-8 with no raw control chars
+inline bool isValidStringContent(const char * begin, const char * end) {
+    return simd::isValidStringContent(begin, end);
+}
+
+// SWAR hex parsing, 4 hex digits packed into little-endian std::uint32_t
+inline bool isMadeOfFourHexDigits(std::uint32_t val) {
+    constexpr std::uint32_t highBits = 0x80808080;
+    // a byte with the high bit set after adding (0x80 - bound) is not less than bound;
+    // bytes over 0x7F fail by their own high bit, so carries out of them don't matter
+    std::uint32_t lower = val | 0x20202020;
+    std::uint32_t digit = (val + 0x50505050) & ~(val + 0x46464646);        /* 0-9 */
+    std::uint32_t letter = (lower + 0x1F1F1F1F) & ~(lower + 0x19191919);   /* A-F, a-f */
+    return ((digit | letter) & ~val & highBits) == highBits;
+}
+
+inline std::uint32_t parseFourHexDigits(std::uint32_t val) {
+    // '0'-'9' have 0x30 high bits, 'A'-'F' and 'a'-'f' 0x40 and 0x60
+    std::uint32_t nibbles = (val & 0x0F0F0F0F) + ((val >> 6) & 0x01010101) * 9;
+    return (nibbles & 0xFF) << 12 | (nibbles >> 8 & 0xFF) << 8 | (nibbles >> 16 & 0xFF) << 4 | nibbles >> 24;
+}
+
+inline std::size_t writeUtf8(std::uint32_t codePoint, char * out) {
+    if(codePoint < 0x80) {
+        out[0] = char(codePoint);
+        return 1;
+    } else if(codePoint < 0x800) {
+        out[0] = char(0xC0 | codePoint >> 6);
+        out[1] = char(0x80 | (codePoint & 0x3F));
+        return 2;
+    } else if(codePoint < 0x10000) {
+        out[0] = char(0xE0 | codePoint >> 12);
+        out[1] = char(0x80 | (codePoint >> 6 & 0x3F));
+        out[2] = char(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    out[0] = char(0xF0 | codePoint >> 18);
+    out[1] = char(0x80 | (codePoint >> 12 & 0x3F));
+    out[2] = char(0x80 | (codePoint >> 6 & 0x3F));
+    out[3] = char(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+inline bool isUnicodeEscapeAt(const InputIteratorConcept auto & pos, const InputIteratorConcept auto & end) {
+    return end - pos >= 2 && *pos == '\\' && *(pos + 1) == 'u';
+}
+
+// pos points to \uXXXX; on success it is moved past it
+template<class InpIter> requires InputIteratorConcept<InpIter>
+bool parseUnicodeEscape(InpIter & pos, const InpIter & end, std::uint32_t & codeUnit, DeserializationContext & ctx) {
+    if(end - pos < 6) [[unlikely]] {
+        ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, 0);
+        return false;
+    }
+    std::uint32_t hex;
+    std::memcpy(&hex, std::to_address(pos) + 2, sizeof(hex));
+    if(!isTrusted<InpIter> && !isMadeOfFourHexDigits(hex)) [[unlikely]] {
+        ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - pos - 2);
+        return false;
+    }
+    codeUnit = parseFourHexDigits(hex);
+    pos += 6;
+    return true;
+}
+
+// pos points to a backslash; on success it is moved to the last char of the escape sequence
+template<class InpIter> requires InputIteratorConcept<InpIter>
+bool checkJsonEscape(InpIter & pos, const InpIter & end, DeserializationContext & ctx) {
+    pos++;
+    if(pos == end) [[unlikely]] {
+        ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - pos);
+        return false;
+    }
+    switch (*pos) {
+    /* Allowed escaped symbols */
+    case '\"':
+    case '/':
+    case '\\':
+    case 'b':
+    case 'f':
+    case 'r':
+    case 'n':
+    case 't':
+        return true;
+        /* Allows escaped symbol \uXXXX */
+    case 'u':
+        for (int i = 0; i < 4; i++) {
+            pos++;
+            if(pos == end) [[unlikely]] {
+                ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - pos);
+                return false;
+            }
+            /* If it isn't a hex character we have an error */
+            auto currChar = *pos;
+            if (!((currChar >= 48 && currChar <= 57) ||     /* 0-9 */
+                  (currChar >= 65 && currChar <= 70) ||     /* A-F */
+                  (currChar >= 97 && currChar <= 102)  )) { /* a-f */
+                ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - pos);
+                return false;
+            }
+        }
+        return true;
+        /* Unexpected symbol */
+    default:
+        ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - pos);
+        return false;
+    }
+}
+
 template<class InpIter> requires InputIteratorConcept<InpIter>
 InpIter findJsonStringEnd(InpIter begin, const InpIter & end, DeserializationContext & ctx) {
+    const char * scanBegin = std::to_address(begin);
+    const char * dataEnd = std::to_address(end);
+    if constexpr(isIndexed<InpIter>) {
+        // with no escapes the closing quote is the next indexed position, strings with
+        // escapes (and broken input) are scanned
+        const char * quote = begin.structurals().seek(scanBegin);
+        if(quote != dataEnd && *quote == '"') [[likely]] {
+            if constexpr(isStrict<InpIter>) {
+                if(!isValidStringContent(scanBegin, quote)) [[unlikely]] {
+                    ctx.setError(DeserializationContext::ILLFORMED_STRING, dataEnd - scanBegin);
+                    return end;
+                }
+            }
+            return begin + (quote - scanBegin);
+        }
+    }
+    bool escapedCarry;
+    bool hasBackslashes;
+    const char * scanEnd = simd::findUnescapedQuote(scanBegin, scanLimit(end), escapedCarry, hasBackslashes);
+    if constexpr(isPadded<InpIter>) {
+        // a quote found in the padding is not the string end
+        if(scanEnd >= dataEnd) {
+            scanEnd = dataEnd;
+            escapedCarry = false;
+        }
+    }
+    if(!isTrusted<InpIter> && hasBackslashes) {
+        // the block scan only tells where the string ends, escapes before that are validated here
+        const char * p = scanBegin;
+        while(p < scanEnd && (p = static_cast<const char *>(std::memchr(p, '\\', scanEnd - p))) != nullptr) {
+            if(!checkJsonEscape(p, dataEnd, ctx)) [[unlikely]] {
+                return end;
+            }
+            p++;
+        }
+    }
+    // the scalar loop restarts from the escaping backslash if a block ended inside an escape
+    begin += (scanEnd - scanBegin) - (escapedCarry ? 1 : 0);
+
     for(; begin != end; begin ++) {
         char c = reinterpret_cast<char>(*begin);
         if(c == '"') {
-            return begin;
-        } else if (c == '\\' && std::next(begin) != end) {
-            int i;
-            begin++;
-            switch (*begin) {
-            /* Allowed escaped symbols */
-            case '\"':
-            case '/':
-            case '\\':
-            case 'b':
-            case 'f':
-            case 'r':
-            case 'n':
-            case 't':
-                break;
-                /* Allows escaped symbol \uXXXX */
-            case 'u': {
-                begin++;
-                auto beforeEscapedSymbol = begin;
-                for (int i = 0; i < 4 && begin != end ; i++) {
-                    /* If it isn't a hex character we have an error */
-                    auto currChar = *begin;
-                    if (!((currChar >= 48 && currChar <= 57) ||     /* 0-9 */
-                          (currChar >= 65 && currChar <= 70) ||     /* A-F */
-                          (currChar >= 97 && currChar <= 102)  )) { /* a-f */
-                        return end;
-                    }
-                    beforeEscapedSymbol = begin;
-                    begin++;
+            if constexpr(isStrict<InpIter>) {
+                if(!isValidStringContent(scanBegin, std::to_address(begin))) [[unlikely]] {
+                    ctx.setError(DeserializationContext::ILLFORMED_STRING, dataEnd - scanBegin);
+                    return end;
                 }
-                begin = beforeEscapedSymbol;
             }
-                break;
-                /* Unexpected symbol */
-            default:
-                ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - begin);
+            return begin;
+        } else if (c == '\\' && std::next(begin) != end) {
+            if constexpr(isTrusted<InpIter>) {
+                begin ++;
+            } else if(!checkJsonEscape(begin, end, ctx)) [[unlikely]] {
                 return end;
             }
         }
@@ -255,7 +758,10 @@ bool extractJSString(InpIter & currentPos, const InpIter & end, DeserializationC
     }
     auto outputI = outputContainer.begin();
 //    auto outputEnd =
-    auto inserter = [&outputContainer, &outputI] (auto b, auto e) -> bool {
+    // raw pointers keep std::copy and insert on memmove for any contiguous input iterator
+    auto inserter = [&outputContainer, &outputI] (auto bIt, auto eIt) -> bool {
+        const char * b = std::to_address(bIt);
+        const char * e = std::to_address(eIt);
         if constexpr (!DynamicContainerTypeConcept<OutputContainerT>) {
             if(e-b <= outputContainer.end() - outputI - 1) {
                 outputI = std::copy(b, e, outputI);
@@ -268,9 +774,16 @@ bool extractJSString(InpIter & currentPos, const InpIter & end, DeserializationC
         }
     };
     auto rangeBegin = currentPos;
+    const char * contentBegin = std::to_address(currentPos);
     for(; currentPos != end; ) {
         auto c = *currentPos;
         if(c == '"') {
+            if constexpr(isStrict<InpIter>) {
+                if(!isValidStringContent(contentBegin, std::to_address(currentPos))) [[unlikely]] {
+                    ctx.setError(DeserializationContext::ILLFORMED_STRING, end - currentPos);
+                    return false;
+                }
+            }
             if(currentPos - rangeBegin > 0) {
                 if(!inserter(rangeBegin, currentPos)) {
                     ctx.setError(DeserializationContext::FIXED_SIZE_CONTAINER_OVERFLOW, end - currentPos);
@@ -326,48 +839,46 @@ bool extractJSString(InpIter & currentPos, const InpIter & end, DeserializationC
                 break;
                 /* Allows escaped symbol \uXXXX */
             case 'u': {
-
-                currentPos++;
-                std::array<char, 4> utf8bytes;
-                auto utfI = utf8bytes.begin();
-                while(true) {
-                    if(currentPos == end) [[unlikely]] {
-                        ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - currentPos);
+                // runs of escapes, usual for producers escaping all non-ASCII text, are decoded into one insert
+                char decoded[64];
+                std::size_t decodedSize = 0;
+                InpIter escape = currentPos - 1;
+                do {
+                    std::uint32_t codePoint;
+                    if(!parseUnicodeEscape(escape, end, codePoint, ctx)) [[unlikely]] {
                         return false;
                     }
-                    if(utfI ==  utf8bytes.end())[[unlikely]] {
-                        break;
-                    }
-                    char currChar = *currentPos;
-                    if (currChar >= 48 && currChar <= 57) {     /* 0-9 */
-                        *utfI = currChar-'0';
-                    } else if(currChar >= 65 && currChar <= 70){     /* A-F */
-                        *utfI = currChar-'A' + 10;
-                    } else if(currChar >= 97 && currChar <= 102) { /* a-f */
-                        *utfI = currChar-'a' + 10;
-                    }
-                    else {
-                        ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - currentPos);
-                        return false;
+                    if(codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+                        // code points past U+FFFF come as two escapes, a high and a low surrogate: D83D DE00 is U+1F600.
+                        // An unpaired one is valid JSON syntax but no text: STRICT rejects it, otherwise it becomes
+                        // U+FFFD and an escape following a lone high surrogate is decoded on its own
+                        std::uint32_t low = 0;
+                        InpIter lowEscape = escape;
+                        bool paired = codePoint <= 0xDBFF && isUnicodeEscapeAt(escape, end);
+                        if(paired) {
+                            if(!parseUnicodeEscape(lowEscape, end, low, ctx)) [[unlikely]] {
+                                return false;
+                            }
+                            paired = low >= 0xDC00 && low <= 0xDFFF;
+                        }
+                        if(paired) [[likely]] {
+                            escape = lowEscape;
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else if constexpr(isStrict<InpIter>) {
+                            ctx.setError(DeserializationContext::ILLFORMED_STRING, end - escape);
+                            return false;
+                        } else {
+                            codePoint = 0xFFFD;
+                        }
                     }
+                    decodedSize += writeUtf8(codePoint, decoded + decodedSize);
+                } while(decodedSize <= sizeof(decoded) - 4 && isUnicodeEscapeAt(escape, end));
 
-                    currentPos++;
-                    utfI ++;
-                }
-                if(currentPos == end) [[unlikely]] {
-                    ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - currentPos);
-                    return false;
-                }
-                char unescaped[3] = {0, 0, 0};
-                unescaped[0] |= (utf8bytes[0] << 4);
-                unescaped[0] |= utf8bytes[1];
-                unescaped[1] |= (utf8bytes[2] << 4);
-                unescaped[1] |= utf8bytes[3];
-                if(!inserter(unescaped, unescaped+2)) {
-                    ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - currentPos);
+                if(!inserter(decoded, decoded + decodedSize)) {
+                    ctx.setError(DeserializationContext::FIXED_SIZE_CONTAINER_OVERFLOW, end - escape);
                     return false;
                 }
-
+                currentPos = escape;
             }
                 break;
                 /* Unexpected symbol */
@@ -379,6 +890,8 @@ bool extractJSString(InpIter & currentPos, const InpIter & end, DeserializationC
 
         } else {
             currentPos++;
+            const char * cleanRunBegin = std::to_address(currentPos);
+            currentPos += simd::findStringSpecial(cleanRunBegin, scanLimit(end)) - cleanRunBegin;
         }
     }
     if(currentPos == end) [[unlikely]] {
@@ -398,9 +911,21 @@ static inline bool is_integer(char c) {
   return (c >= '0' && c <= '9');
 }
 bool skipDouble(InputIteratorConcept auto & begin, const InputIteratorConcept auto & end, DeserializationContext & ctx) {
+   // the zero after padded input ends digit runs
+   constexpr bool padded = isPadded<decltype(begin)>;
+   if constexpr(isTrusted<decltype(begin)>) {
+       while(!isPlainEnd(*begin)) {
+           begin ++;
+           if (!padded && begin == end) [[unlikely]] {
+               ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
+               return false;
+           }
+       }
+       return true;
+   }
    if(*begin == '-') {
        begin ++;
-       if (begin == end) [[unlikely]] {
+       if (!padded && begin == end) [[unlikely]] {
            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
            return false;
        }
@@ -413,21 +938,21 @@ bool skipDouble(InputIteratorConcept auto & begin, const InputIteratorConcept au
    if(*begin != '0') {
        while(is_integer(*begin)) {
            begin ++;
-           if (begin == end) [[unlikely]] {
+           if (!padded && begin == end) [[unlikely]] {
                ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
                return false;
            }
        }
    } else {
        begin ++;
-       if (begin == end) [[unlikely]] {
+       if (!padded && begin == end) [[unlikely]] {
            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
            return false;
        }
    }
    if(*begin == '.') {
        begin ++;
-       if (begin == end) [[unlikely]] {
+       if (!padded && begin == end) [[unlikely]] {
            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
            return false;
        }
@@ -437,7 +962,7 @@ bool skipDouble(InputIteratorConcept auto & begin, const InputIteratorConcept au
        }
        while(is_integer(*begin)) {
            begin ++;
-           if (begin == end) [[unlikely]] {
+           if (!padded && begin == end) [[unlikely]] {
                ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
                return false;
            }
@@ -445,20 +970,24 @@ bool skipDouble(InputIteratorConcept auto & begin, const InputIteratorConcept au
    }
    if(*begin == 'e'||*begin == 'E') {
        begin ++;
-       if (begin == end) [[unlikely]] {
+       if (!padded && begin == end) [[unlikely]] {
            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
            return false;
        }
        if(*begin == '+'||*begin == '-') {
            begin ++;
-           if (begin == end) [[unlikely]] {
+           if (!padded && begin == end) [[unlikely]] {
                ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
                return false;
            }
        }
+       if(!is_integer(*begin)) {
+           ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, end - begin);
+           return false;
+       }
        while(is_integer(*begin)) {
            begin ++;
-           if (begin == end) [[unlikely]] {
+           if (!padded && begin == end) [[unlikely]] {
                ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
                return false;
            }
@@ -481,6 +1010,7 @@ bool skipPlainJsonValue(InpIter & begin, const InpIter & end, DeserializationCon
     {
         begin ++;
         if(begin == end) [[unlikely]] {
+            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
             return false;
         }
             InpIter keyBegin = begin;
@@ -491,6 +1021,7 @@ bool skipPlainJsonValue(InpIter & begin, const InpIter & end, DeserializationCon
         begin = keyEnd;
         begin ++;
         if(begin == end) [[unlikely]] {
+            ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, end - begin);
             return false;
         }
         return true;
@@ -498,7 +1029,7 @@ bool skipPlainJsonValue(InpIter & begin, const InpIter & end, DeserializationCon
         break;
     case 't':
     {
-        if(end-begin>=5 && *(begin+0) == 't'&&*(begin+1) == 'r'&&*(begin+2) == 'u'&&*(begin+3) == 'e'&&d::isPlainEnd(*(begin+4))) {
+        if(end-begin>=5 && (isTrusted<InpIter> || (*(begin+0) == 't'&&*(begin+1) == 'r'&&*(begin+2) == 'u'&&*(begin+3) == 'e'&&d::isPlainEnd(*(begin+4))))) {
             begin += 4;
             return true;
         }
@@ -507,7 +1038,7 @@ bool skipPlainJsonValue(InpIter & begin, const InpIter & end, DeserializationCon
         break;
     case 'f':
     {
-        if(end-begin>=6 && *(begin+0) == 'f'&&*(begin+1) == 'a'&&*(begin+2) == 'l'&&*(begin+3) == 's'&&*(begin+4) == 'e'&&d::isPlainEnd(*(begin+5))) {
+        if(end-begin>=6 && (isTrusted<InpIter> || (*(begin+0) == 'f'&&*(begin+1) == 'a'&&*(begin+2) == 'l'&&*(begin+3) == 's'&&*(begin+4) == 'e'&&d::isPlainEnd(*(begin+5))))) {
             begin += 5;
             return true;
         }
@@ -515,7 +1046,7 @@ bool skipPlainJsonValue(InpIter & begin, const InpIter & end, DeserializationCon
     }
         break;
     case 'n':
-        if(end-begin>=5 && *(begin+0) == 'n'&&*(begin+1) == 'u'&&*(begin+2) == 'l'&&*(begin+3) == 'l'&&d::isPlainEnd(*(begin+4))) {
+        if(end-begin>=5 && (isTrusted<InpIter> || (*(begin+0) == 'n'&&*(begin+1) == 'u'&&*(begin+2) == 'l'&&*(begin+3) == 'l'&&d::isPlainEnd(*(begin+4))))) {
             begin += 4;
             return true;
         }
@@ -553,8 +1084,8 @@ bool skipArrayJsonValue(std::uint8_t & recursionLevelRemains, InputIteratorConce
         if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
             return false;
         }
-        if(*begin == ',') {
-            begin ++;
+        if(!d::skipValueSeparator(begin, end, ']', ctx)) [[unlikely]] {
+            return false;
         }
     }
     ctx.setError(DeserializationContext::INTERNAL_ERROR, end - begin);
@@ -607,14 +1138,121 @@ bool skipObjectJsonValue(std::uint8_t & recursionLevelRemains, InpIter & begin,
         if(!d::skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
             return false;
         }
-        if(*begin == ',') {
-            begin ++;
+        if(!d::skipValueSeparator(begin, end, '}', ctx)) [[unlikely]] {
+            return false;
         }
     }
     ctx.setError(DeserializationContext::SKIPPING_ERROR, end - begin);
     return false;
 }
 
+// What the next indexed token may be while a skipped container is stepped over
+enum class IndexedSkipState {
+    VALUE_OR_CLOSE,   // after [ or a comma in an array
+    KEY_OR_CLOSE,     // after { or a comma in an object
+    COLON,            // after a key
+    VALUE,            // after a colon
+    AFTER_VALUE       // a comma, the closing bracket or, with no comma, the next item
+};
+
+// Indexed input, unless strict: a skipped array or object is stepped over by the index entries,
+// with the grammar of the plain skip. Brackets are matched on a stack as deep as the recursion
+// limit, strings are checked for their escapes and scalars by skipPlainJsonValue()
+template<class InpIter> requires InputIteratorConcept<InpIter>
+bool skipIndexedContainer(std::uint8_t recursionLevelRemains, InpIter & begin, const InpIter & end, DeserializationContext & ctx) {
+    using ScalarIter = RawInputIterator<false, InputMode<std::decay_t<InpIter>>::validation>;
+    StructuralCursor & structurals = begin.structurals();
+    const char * opening = std::to_address(begin);
+    const char * dataEnd = std::to_address(end);
+    if(structurals.seek(opening) != opening) [[unlikely]] {
+        ctx.setError(DeserializationContext::SKIPPING_ERROR, end - begin);
+        return false;
+    }
+    // closing brackets of the open containers, a value at depth n takes n recursion levels
+    char closings[std::numeric_limits<std::uint8_t>::max() + 1];
+    std::size_t depth = 1;
+    closings[0] = *opening == '[' ? ']' : '}';
+    IndexedSkipState state = *opening == '[' ? IndexedSkipState::VALUE_OR_CLOSE : IndexedSkipState::KEY_OR_CLOSE;
+    for(const char * p = structurals.next(); p != dataEnd; p = structurals.next()) {
+        const bool inArray = closings[depth - 1] == ']';
+        const bool key = state == IndexedSkipState::KEY_OR_CLOSE || (state == IndexedSkipState::AFTER_VALUE && !inArray);
+        const bool value = state == IndexedSkipState::VALUE || (inArray && (state == IndexedSkipState::VALUE_OR_CLOSE || state == IndexedSkipState::AFTER_VALUE));
+        switch(*p) {
+        case ']':
+        case '}':
+            if(*p != closings[depth - 1] || state == IndexedSkipState::COLON || state == IndexedSkipState::VALUE) [[unlikely]] {
+                ctx.setError(DeserializationContext::SKIPPING_ERROR, dataEnd - p);
+                return false;
+            }
+            if(-- depth == 0) {
+                begin += p + 1 - opening;
+                structurals.next();
+                return true;
+            }
+            state = IndexedSkipState::AFTER_VALUE;
+            continue;
+        case ',':
+            if(state != IndexedSkipState::AFTER_VALUE) [[unlikely]] {
+                ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, dataEnd - p);
+                return false;
+            }
+            state = inArray ? IndexedSkipState::VALUE_OR_CLOSE : IndexedSkipState::KEY_OR_CLOSE;
+            continue;
+        case ':':
+            if(state != IndexedSkipState::COLON) [[unlikely]] {
+                ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, dataEnd - p);
+                return false;
+            }
+            state = IndexedSkipState::VALUE;
+            continue;
+        }
+        if(!value && !(key && *p == '"')) [[unlikely]] {
+            ctx.setError(DeserializationContext::UNEXPECTED_SYMBOL, dataEnd - p);
+            return false;
+        }
+        if(value && depth >= recursionLevelRemains) [[unlikely]] {
+            ctx.setError(DeserializationContext::SKIPPING_MAX_RECURSION, dataEnd - p);
+            return false;
+        }
+        state = value ? IndexedSkipState::AFTER_VALUE : IndexedSkipState::COLON;
+        switch(*p) {
+        case '[':
+            closings[depth ++] = ']';
+            state = IndexedSkipState::VALUE_OR_CLOSE;
+            break;
+        case '{':
+            closings[depth ++] = '}';
+            state = IndexedSkipState::KEY_OR_CLOSE;
+            break;
+        case '"':
+            // the entries up to the closing quote are escapes
+            for(p = structurals.next(); p != dataEnd && *p != '"'; p = structurals.next()) {
+                if constexpr(!isTrusted<InpIter>) {
+                    const char * escape = p;
+                    if(!checkJsonEscape(escape, dataEnd, ctx)) [[unlikely]] {
+                        return false;
+                    }
+                }
+            }
+            if(p == dataEnd) [[unlikely]] {
+                ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, 0);
+                return false;
+            }
+            break;
+        default:
+        {
+            ScalarIter scalar(p);
+            if(!skipPlainJsonValue(scalar, ScalarIter(dataEnd), ctx)) [[unlikely]] {
+                return false;
+            }
+            break;
+        }
+        }
+    }
+    ctx.setError(DeserializationContext::UNEXPECTED_END_OF_DATA, 0);
+    return false;
+}
+
 bool skipJsonValue(std::uint8_t & recursionLevelRemains, InputIteratorConcept auto & begin, const InputIteratorConcept auto & end, DeserializationContext & ctx) {
     if(!skipWhiteSpace(begin, end, ctx)) [[unlikely]] {
         return false;
@@ -625,12 +1263,21 @@ bool skipJsonValue(std::uint8_t & recursionLevelRemains, InputIteratorConcept au
         return false;
     }
     bool r = false;
+    constexpr bool indexedSkip = isIndexed<decltype(begin)> && !isStrict<decltype(begin)>;
     switch(*begin) {
     case '[':
-        r = skipArrayJsonValue(recursionLevelRemains, begin, end, ctx);
+        if constexpr(indexedSkip) {
+            r = skipIndexedContainer(recursionLevelRemains, begin, end, ctx);
+        } else {
+            r = skipArrayJsonValue(recursionLevelRemains, begin, end, ctx);
+        }
         break;
     case '{':
-        r =  skipObjectJsonValue(recursionLevelRemains, begin, end, ctx);
+        if constexpr(indexedSkip) {
+            r = skipIndexedContainer(recursionLevelRemains, begin, end, ctx);
+        } else {
+            r =  skipObjectJsonValue(recursionLevelRemains, begin, end, ctx);
+        }
         break;
     default:
         r =  skipPlainJsonValue(begin, end, ctx);
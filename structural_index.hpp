@@ -0,0 +1,374 @@
+#ifndef STRUCTURAL_INDEX_HPP
+#define STRUCTURAL_INDEX_HPP
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <barrier>
+#include <exception>
+#include "simd_ops.hpp"
+
+namespace JSONReflection {
+
+namespace d {
+
+// Entries are 32-bit offsets from the start of their segment of the input. Blocks are 64 bytes
+// from the data start, so even the end of data is less than a segment after the last one
+inline constexpr std::size_t IndexSegmentSize = std::size_t(1) << 32;
+
+// Index entries, written by the indexing kernel in batches with one capacity check per batch
+struct IndexEntries {
+    std::unique_ptr<std::uint32_t[]> entries;
+    std::size_t capacity = 0;
+    std::size_t size = 0;
+    // the first entry of every segment
+    std::vector<std::size_t> segmentBegins;
+
+    void reserve(std::size_t n) {
+        if(n <= capacity) {
+            return;
+        }
+        std::size_t newCapacity = std::max(n, capacity * 2);
+        if(size == 0) {
+            // nothing to keep, the old entries are freed before the allocation;
+            // if it throws, the emptied index reserves again at the next build
+            entries.reset();
+            capacity = 0;
+        }
+        std::unique_ptr<std::uint32_t[]> newEntries(new std::uint32_t[newCapacity]);
+        std::copy(entries.get(), entries.get() + size, newEntries.get());
+        entries = std::move(newEntries);
+        capacity = newCapacity;
+    }
+
+    // Writes the entries of whole 64-byte blocks [begin, end) of data from out on, split at segment borders
+    std::uint32_t * write(const char * data, const char * begin, const char * end, std::uint32_t * out, simd::IndexCarry & carry) {
+        while(begin != end) {
+            std::size_t segment = std::size_t(begin - data) / IndexSegmentSize;
+            const char * base = data + segment * IndexSegmentSize;
+            if(begin == base) {
+                segmentBegins[segment] = out - entries.get();
+            }
+            const char * stop = std::size_t(end - base) > IndexSegmentSize ? base + IndexSegmentSize : end;
+            out = simd::indexStructurals(begin, stop, base, out, carry);
+            begin = stop;
+        }
+        return out;
+    }
+
+    // Whole 64-byte blocks of [begin, end); each byte takes at most one entry
+    void append(const char * data, const char * begin, const char * end, simd::IndexCarry & carry) {
+        constexpr std::size_t batchSize = std::size_t(1) << 16;
+        while(begin != end) {
+            std::size_t n = std::min<std::size_t>(end - begin, batchSize);
+            reserve(size + n + 1);
+            size = write(data, begin, begin + n, entries.get() + size, carry) - entries.get();
+            begin += n;
+        }
+    }
+};
+
+// Chunks of a multi-threaded index build are at least this long
+inline constexpr std::size_t MinIndexChunkSize = std::size_t(1) << 20;
+
+inline bool isIndexBoundary(char c) {
+    switch(c) {
+    case '{': case '}': case '[': case ']': case ':': case ',':
+    case ' ': case '\n': case '\r': case '\t':
+        return true;
+    }
+    return false;
+}
+
+// The char at p follows an odd run of backslashes
+inline bool isEscapedAt(const char * data, const char * p) {
+    const char * runBegin = p;
+    while(runBegin != data && *(runBegin - 1) == '\\') {
+        runBegin --;
+    }
+    return (p - runBegin) % 2 == 1;
+}
+
+/*
+ * Carry for indexing a chunk at chunk > data with no look at the data before it. Escape and
+ * boundary state depend on a few preceding bytes only. Whether the chunk starts inside a string
+ * is a guess: after the nearest quote before it, a closing one is followed by ,:]} in valid JSON,
+ * an opening one usually is not. The guess is checked by the quote parity of all previous chunks
+ */
+inline simd::IndexCarry guessChunkCarry(const char * data, const char * chunk, const char * dataEnd) {
+    constexpr std::ptrdiff_t quoteLookBehind = 4096;
+    simd::IndexCarry carry;
+    carry.prevEscaped = isEscapedAt(data, chunk) ? 1 : 0;
+    char last = *(chunk - 1);
+    carry.prevBoundary = isIndexBoundary(last) || (last == '"' && !isEscapedAt(data, chunk - 1)) ? 1 : 0;
+    carry.inString = 0;
+    const char * lookBehindEnd = chunk - std::min(chunk - data, quoteLookBehind);
+    for(const char * q = chunk - 1; q >= lookBehindEnd; q --) {
+        if(*q == '"' && !isEscapedAt(data, q)) {
+            const char * next = q + 1;
+            while(next != dataEnd && (*next == ' ' || *next == '\n' || *next == '\r' || *next == '\t')) {
+                next ++;
+            }
+            bool closing = next != dataEnd && (*next == ',' || *next == ':' || *next == ']' || *next == '}');
+            carry.inString = closing ? 0 : ~std::uint64_t(0);
+            break;
+        }
+    }
+    return carry;
+}
+
+// Runs f(0, sync) ... f(n - 1, sync) once each, in its own thread but the first one; sync is a
+// barrier of n threads for the phases of f. f must not throw, if a thread can't be started the
+// first one and the missing ones leave the barrier and the others run to the end unsynchronized
+template <class F>
+void runInParallel(std::size_t n, F && f) {
+    std::barrier<> sync{std::ptrdiff_t(n)};
+    std::vector<std::thread> threads;
+    threads.reserve(n - 1);
+    std::exception_ptr failure;
+    try {
+        for(std::size_t i = 1; i < n; i ++) {
+            threads.emplace_back([&f, &sync, i]() { f(i, sync); });
+        }
+    } catch(...) {
+        failure = std::current_exception();
+        for(std::size_t i = threads.size(); i < n; i ++) {
+            sync.arrive_and_drop();
+        }
+    }
+    if(!failure) {
+        f(0, sync);
+    }
+    for(std::thread & t: threads) {
+        t.join();
+    }
+    if(failure) [[unlikely]] {
+        std::rethrow_exception(failure);
+    }
+}
+
+class StructuralCursor;
+
+}
+
+/*
+ * Stage 1 of DeserializeIndexed(): positions of the structural chars {}[]:, outside strings,
+ * of both quotes of every string, of escapes in strings and of the first char of every number
+ * and literal, found in one vectorized pass. Parsers then jump between them instead of scanning
+ * the input byte by byte. Every entry is a 32-bit offset in its 4 GB segment of the input, 4 bytes
+ * per token, up to 4 bytes per input byte for a document of single-digit numbers; keep one index
+ * to reuse its memory.
+ *
+ * With threads > 1 (0 is one per core) documents of several MinIndexChunkSize are split into
+ * chunks processed in parallel. Each chunk guesses whether it starts inside a string and counts
+ * its entries; a prefix pass over the quote parities of the chunks finds the real states, the
+ * chunks guessed wrong are counted once more, and then every chunk writes its entries straight
+ * into its slice of the index. The threads are started once per build and go through these steps
+ * on a barrier. Memory is the same as for one thread. Parsing stays single-threaded
+ */
+class StructuralIndex {
+    friend class d::StructuralCursor;
+
+    struct Chunk {
+        const char * begin;
+        const char * end;
+        d::simd::IndexCarry start;
+        d::simd::IndexCarry carry;
+        std::size_t count;
+        std::size_t offset;
+        bool recount;
+    };
+
+    d::IndexEntries m_index;
+    const char * m_data = nullptr;
+    std::vector<Chunk> m_chunks;
+    unsigned m_threads;
+
+    // whole blocks in [data, blocksEnd), returns the carry for the rest
+    d::simd::IndexCarry buildInParallel(const char * data, const char * blocksEnd, const char * dataEnd, std::size_t chunkCount) {
+        std::size_t chunkSize = (blocksEnd - data) / chunkCount / 64 * 64;
+        m_chunks.resize(chunkCount);
+        for(std::size_t i = 0; i < chunkCount; i ++) {
+            Chunk & c = m_chunks[i];
+            c.begin = data + i * chunkSize;
+            c.end = i + 1 == chunkCount ? blocksEnd : c.begin + chunkSize;
+            c.start = i == 0 ? d::simd::IndexCarry{} : d::guessChunkCarry(data, c.begin, dataEnd);
+            c.recount = true;
+        }
+        // the workers are started once, the first one runs the serial steps between the phases
+        bool misguessed = false;
+        bool reserved = false;
+        std::exception_ptr allocationFailure;
+        m_index.size = 0;
+        d::runInParallel(chunkCount, [&](std::size_t i, std::barrier<> & sync) {
+            Chunk & c = m_chunks[i];
+            auto countChunk = [&c]() {
+                if(c.recount) {
+                    c.carry = c.start;
+                    c.count = d::simd::countStructurals(c.begin, c.end, c.carry);
+                }
+            };
+            countChunk();
+            sync.arrive_and_wait();
+            if(i == 0) {
+                misguessed = findChunkStates();
+            }
+            sync.arrive_and_wait();
+            if(misguessed) [[unlikely]] {
+                countChunk();
+                sync.arrive_and_wait();
+            }
+            if(i == 0) {
+                try {
+                    reserveChunkSlices();
+                    reserved = true;
+                } catch(...) {
+                    allocationFailure = std::current_exception();
+                }
+            }
+            sync.arrive_and_wait();
+            if(reserved) {
+                d::simd::IndexCarry carry = c.start;
+                m_index.write(data, c.begin, c.end, m_index.entries.get() + c.offset, carry);
+            }
+        });
+        if(allocationFailure) [[unlikely]] {
+            std::rethrow_exception(allocationFailure);
+        }
+        return m_chunks.back().carry;
+    }
+
+    // The quote parity of a chunk doesn't depend on the guess: a prefix pass over the parities
+    // fixes the start states, true if a chunk has to be counted again
+    bool findChunkStates() {
+        std::uint64_t inString = 0;
+        bool misguessed = false;
+        for(Chunk & c: m_chunks) {
+            std::uint64_t parity = c.start.inString ^ c.carry.inString;
+            c.recount = c.start.inString != inString;
+            c.start.inString = inString;
+            inString ^= parity;
+            misguessed |= c.recount;
+        }
+        return misguessed;
+    }
+
+    void reserveChunkSlices() {
+        std::size_t total = 0;
+        for(Chunk & c: m_chunks) {
+            c.offset = total;
+            total += c.count;
+        }
+        m_index.reserve(total + 64 + 1);
+        m_index.size = total;
+    }
+public:
+    explicit StructuralIndex(unsigned threads = 1): m_threads(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    void build(const char * data, std::size_t size) {
+        const char * blocksEnd = data + size / 64 * 64;
+        std::size_t chunkCount = std::min<std::size_t>(m_threads, (blocksEnd - data) / d::MinIndexChunkSize);
+        // the last partial block is in the segment of blocksEnd, its first entries start it on a segment border
+        std::size_t tailSegment = std::size_t(blocksEnd - data) / d::IndexSegmentSize;
+        const char * tailBase = data + tailSegment * d::IndexSegmentSize;
+        m_data = data;
+        m_index.segmentBegins.assign(tailSegment + 1, 0);
+        d::simd::IndexCarry carry;
+        if(chunkCount > 1) {
+            carry = buildInParallel(data, blocksEnd, data + size, chunkCount);
+        } else {
+            m_index.size = 0;
+            m_index.append(data, data, blocksEnd, carry);
+        }
+        if(blocksEnd == tailBase) {
+            m_index.segmentBegins[tailSegment] = m_index.size;
+        }
+        // the last partial block, padded with spaces
+        char tail[64];
+        std::memset(tail, ' ', sizeof(tail));
+        std::memcpy(tail, blocksEnd, data + size - blocksEnd);
+        m_index.reserve(m_index.size + sizeof(tail) + 1);
+        std::uint32_t * tailBegin = m_index.entries.get() + m_index.size;
+        std::uint32_t * tailEnd = d::simd::indexStructurals(tail, tail + sizeof(tail), tail, tailBegin, carry);
+        for(std::uint32_t * e = tailBegin; e != tailEnd; e ++) {
+            *e += std::uint32_t(blocksEnd - tailBase);
+        }
+        m_index.size = tailEnd - m_index.entries.get();
+        // the end of data stops every lookup
+        m_index.entries[m_index.size] = std::uint32_t(data + size - tailBase);
+    }
+
+    // Number of indexed positions
+    std::size_t size() const {
+        return m_index.size;
+    }
+    // Offsets in the segments of the input
+    const std::uint32_t * begin() const {
+        return m_index.entries.get();
+    }
+    const std::uint32_t * end() const {
+        return m_index.entries.get() + m_index.size;
+    }
+};
+
+namespace d {
+
+// Shared by all iterators of one DeserializeIndexed() pass. Parsing goes forward,
+// so lookups usually step over a few entries from the previous one
+class StructuralCursor {
+    const IndexEntries & index;
+    const char * data;
+    std::size_t segment;
+    const char * base;
+    const std::uint32_t * segmentBegin;
+    const std::uint32_t * segmentEnd;
+    const std::uint32_t * current;
+
+    // current stays, it is the first entry of the segment when stepping into the next one
+    void enterSegment(std::size_t s) {
+        segment = s;
+        base = data + s * IndexSegmentSize;
+        segmentBegin = index.entries.get() + index.segmentBegins[s];
+        // the last segment holds the end of data entry
+        segmentEnd = s + 1 != index.segmentBegins.size() ? index.entries.get() + index.segmentBegins[s + 1] : index.entries.get() + index.size + 1;
+    }
+    // segments with no entries are passed
+    void skipEmptySegments() {
+        while(current == segmentEnd) [[unlikely]] {
+            enterSegment(segment + 1);
+        }
+    }
+public:
+    explicit StructuralCursor(const StructuralIndex & index): index(index.m_index), data(index.m_data) {
+        enterSegment(0);
+        current = segmentBegin;
+        skipEmptySegments();
+    }
+
+    const char * position() const {
+        return base + *current;
+    }
+    // The next indexed position, never called at the end of data
+    const char * next() {
+        current ++;
+        skipEmptySegments();
+        return position();
+    }
+    // The first indexed position at p or after it, the end of data if there is none
+    const char * seek(const char * p) {
+        if(p < base || (current != segmentBegin && base + *(current - 1) >= p)) [[unlikely]] {
+            enterSegment(std::min(std::size_t(p - data) / IndexSegmentSize, index.segmentBegins.size() - 1));
+            current = std::lower_bound(segmentBegin, segmentEnd, std::uint32_t(p - base));
+            skipEmptySegments();
+        }
+        while(position() < p) {
+            next();
+        }
+        return position();
+    }
+};
+
+}
+}
+#endif // STRUCTURAL_INDEX_HPP
@@ -4,6 +4,7 @@
 
 #include "fstream"
 #include <string.h>
+#include <cstdio>
 
 using JSONReflection::J;
 using std::vector, std::list, std::array, std::string, std::int64_t;
@@ -93,6 +94,43 @@ struct Root_ {
 };
 
 using Root = J<Root_>;
+
+// Tweet ids only, the rest of the document is skipped
+struct TweetId {
+    J<int64_t,             "id">        id;
+};
+struct IdsRoot_ {
+    J<vector<J<TweetId>>, "statuses"> statuses;
+};
+using IdsRoot = J<IdsRoot_>;
+
+// The same document from a producer which escapes all non-ASCII text, like many Java and .NET ones
+string escapeNonAscii(const string & inp) {
+    string out;
+    char buf[16];
+    for(std::size_t i = 0; i < inp.size(); ) {
+        unsigned char c = inp[i];
+        if(c < 0x80) {
+            out += char(c);
+            i ++;
+            continue;
+        }
+        int length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2;
+        std::uint32_t codePoint = c & (0x7F >> length);
+        for(int k = 1; k < length; k ++) {
+            codePoint = codePoint << 6 | (inp[i + k] & 0x3F);
+        }
+        i += length;
+        if(codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            snprintf(buf, sizeof(buf), "\\u%04X\\u%04X", 0xD800 + (codePoint >> 10), 0xDC00 + (codePoint & 0x3FF));
+        } else {
+            snprintf(buf, sizeof(buf), "\\u%04x", codePoint);
+        }
+        out += buf;
+    }
+    return out;
+}
 }
 int twitterJsonPerfTest() {
     std::ifstream ifs("../../twitter.json");
@@ -104,9 +142,11 @@ int twitterJsonPerfTest() {
     Twi::Root root;
     bool res;
 
-    res = root.Deserialize(b, e);
-    if(!res)
+    auto ctx = root.Deserialize(b, e);
+    if(!ctx)
         throw 1;
+    auto keyStats = ctx.keyMatchStats();
+    std::cout << "Keys predicted: " << keyStats.predicted << ", looked up: " << keyStats.lookedUp << ", unknown: " << keyStats.unknown << std::endl;
     std::cout << root.statuses.size() << std::endl;
     std::cout <<  string(root.statuses.front().text)<< std::endl;
 
@@ -118,6 +158,119 @@ int twitterJsonPerfTest() {
         if(!res) throw 1;
     });
 
+    // statuses keep the same key order, which differs from Twi::Tweet declaration
+    ctx = root.Deserialize(b, e, JSONReflection::ParseFlags::LEARN_KEY_ORDER);
+    if(!ctx)
+        throw 1;
+    keyStats = ctx.keyMatchStats();
+    std::cout << "Keys predicted with learned order: " << keyStats.predicted << ", looked up: " << keyStats.lookedUp << ", unknown: " << keyStats.unknown << std::endl;
+
+    doPerformanceTest("twitter.json parsing, learned key order", 1000, [&res, &root, &b, &e]{
+        res = root.Deserialize(b, e, JSONReflection::ParseFlags::LEARN_KEY_ORDER);
+
+        if(!res) throw 1;
+    });
+
+    string padded = inp;
+    padded.resize(inp.size() + JSONReflection::DeserializePadding);
+    doPerformanceTest("twitter.json parsing, padded input", 1000, [&res, &root, &padded, &inp]{
+        res = root.DeserializePadded(padded.data(), inp.size());
+
+        if(!res) throw 1;
+    });
+
+    doPerformanceTest("twitter.json parsing, trusted input", 1000, [&res, &root, &inp]{
+        res = root.Deserialize(inp, JSONReflection::ParseFlags::TRUSTED_INPUT);
+
+        if(!res) throw 1;
+    });
+
+    doPerformanceTest("twitter.json parsing, trusted padded input", 1000, [&res, &root, &padded, &inp]{
+        res = root.DeserializePadded(padded.data(), inp.size(), JSONReflection::ParseFlags::TRUSTED_INPUT);
+
+        if(!res) throw 1;
+    });
+
+    doPerformanceTest("twitter.json parsing, strict", 1000, [&res, &root, &inp]{
+        res = root.Deserialize(inp, JSONReflection::ParseFlags::STRICT);
+
+        if(!res) throw 1;
+    });
+
+    {
+        using JSONReflection::SimdLevel;
+        SimdLevel initial = JSONReflection::simdLevel();
+        for(auto [level, name]: {std::pair{SimdLevel::SSE2, "SSE2"}, {SimdLevel::SSE4_2, "SSE4.2"}, {SimdLevel::AVX2, "AVX2"}, {SimdLevel::AVX512, "AVX-512"}}) {
+            if(level == initial || !JSONReflection::setSimdLevel(level)) {
+                continue;
+            }
+            doPerformanceTest(string("twitter.json parsing, ") + name + " kernels", 1000, [&res, &root, &inp]{
+                res = root.Deserialize(inp);
+
+                if(!res) throw 1;
+            });
+        }
+        JSONReflection::setSimdLevel(initial);
+    }
+
+    JSONReflection::StructuralIndex index;
+    doPerformanceTest("twitter.json structural index", 1000, [&index, &inp]{
+        index.build(inp.data(), inp.size());
+    });
+    // concatenated copies, indexing doesn't care
+    string large;
+    while(large.size() < 16 * 1024 * 1024) {
+        large += inp;
+    }
+    for(unsigned threads: {1u, 2u, 4u, 8u}) {
+        JSONReflection::StructuralIndex largeIndex(threads);
+        doPerformanceTest("16 MB structural index, " + std::to_string(threads) + " threads", 20, [&largeIndex, &large]{
+            largeIndex.build(large.data(), large.size());
+        });
+    }
+    doPerformanceTest("twitter.json parsing, indexed", 1000, [&res, &root, &index, &inp]{
+        res = root.DeserializeIndexed(inp, index);
+
+        if(!res) throw 1;
+    });
+    {
+        Twi::IdsRoot ids;
+        doPerformanceTest("twitter.json parsing, ids only", 1000, [&res, &ids, &inp]{
+            res = ids.Deserialize(inp);
+
+            if(!res) throw 1;
+        });
+        doPerformanceTest("twitter.json parsing, ids only, indexed", 1000, [&res, &ids, &index, &inp]{
+            res = ids.DeserializeIndexed(inp, index);
+
+            if(!res) throw 1;
+        });
+        if(ids.statuses.size() != root.statuses.size() || ids.statuses.back().id != root.statuses.back().id) {
+            throw 1;
+        }
+    }
+
+    string escaped = Twi::escapeNonAscii(inp);
+    std::cout << "escaped.size " << escaped.size() << std::endl;
+    {
+        Twi::Root fromEscaped;
+        string o1, o2;
+        if(!root.Deserialize(inp) || !fromEscaped.Deserialize(escaped) || !root.Serialize(o1) || !fromEscaped.Serialize(o2) || o1 != o2) {
+            throw 1;
+        }
+    }
+    doPerformanceTest("twitter.json parsing, non-ASCII escaped", 1000, [&res, &root, &escaped]{
+        res = root.Deserialize(escaped);
+
+        if(!res) throw 1;
+    });
+
+    string output;
+    doPerformanceTest("twitter.json serializing", 1000, [&root, &output]{
+        output.clear();
+        if(!root.Serialize(output)) throw 1;
+    });
+    std::cout << "Serialized size: " << output.size() << std::endl;
 
     return 0;
 }